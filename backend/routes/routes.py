@@ -1,9 +1,12 @@
 from fastapi import APIRouter, HTTPException, Depends, Request, BackgroundTasks
 from fastapi.responses import StreamingResponse
+from sqlalchemy import func
 from sqlalchemy.orm import Session
 from typing import Optional, List, Dict, Any
+import asyncio
 import logging
 import json
+import time
 
 # Import services
 from services.llm_service import llm_service
@@ -306,6 +309,36 @@ async def get_conversations(
     conversations = query.order_by(AgentConversation.created_at.desc()).offset(skip).limit(limit).all()
     return conversations
 
+@router.get("/conversations/updates")
+async def poll_conversation_updates(
+    request: Request,
+    after_id: int = 0,
+    timeout: int = 20,
+    db: Session = Depends(get_db),
+    api_key = Depends(verify_api_key)
+):
+    """
+    Long-poll cho push-based updates: giữ request mở tới khi có conversation
+    mới hơn after_id (hoặc hết timeout) thay vì client phải poll
+    GET /conversations định kỳ và nhận full payload dù không có gì đổi.
+
+    Client dùng latest_id trong response làm after_id cho lần poll kế tiếp.
+    Đọc qua max(id) nên hoạt động đúng với nhiều worker process / nhiều
+    frontend instance cùng trỏ vào một database.
+    """
+    timeout = max(1, min(timeout, 60))
+    deadline = time.monotonic() + timeout
+    while True:
+        latest = db.query(func.max(AgentConversation.id)).scalar() or 0
+        if latest > after_id:
+            return {"changed": True, "latest_id": latest}
+        if time.monotonic() >= deadline:
+            return {"changed": False, "latest_id": latest}
+        # Kết thúc read transaction hiện tại để iteration sau thấy được
+        # commit từ request khác (session giữ snapshot tới khi rollback/commit)
+        db.rollback()
+        await asyncio.sleep(1.0)
+
 # LLM Management endpoints
 @router.get("/api/llm/status")
 async def get_llm_status(request: Request, api_key = Depends(verify_api_key)):
@@ -0,0 +1,264 @@
+#include <windows.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "../src/ui/MainWindow.h"
+#include "../src/ui/MainWindowHelpers.h"
+#include "../src/core/JsonParser.h"
+#include "../src/core/SearchIndex.h"
+#include "../src/core/ExportService.h"
+#include "../src/core/GDIResourceManager.h"
+
+// FrontendBench - microbenchmark cho các hot path của frontend
+//
+// Console app chạy tay (không phải CI gate): đo throughput của những đoạn
+// chiếm phần lớn profile - layout/measure text như DrawChatMessages,
+// JsonParser::ParseArray trên payload tổng hợp 1-32MB, SearchIndex trên
+// transcript lớn, và ExportService ghi file. In thời gian per-iteration
+// để so sánh giữa các release; chạy vài lần và lấy số ổn định vì GDI/IO
+// phụ thuộc máy.
+//
+// Build target SenAIFrontendBench (xem CMakeLists.txt), chạy không tham số.
+
+namespace {
+
+// ===================== Timing helpers =====================
+
+double NowMs() {
+    static LARGE_INTEGER freq = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return f;
+    }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+}
+
+// Chạy fn() `iterations` lần, in min/avg per-iteration và throughput
+// (bytesPerIter = 0 -> bỏ cột MB/s)
+template <typename Fn>
+void RunBench(const char* name, int iterations, size_t bytesPerIter, Fn fn) {
+    double totalMs = 0.0;
+    double minMs = 1e18;
+    for (int i = 0; i < iterations; i++) {
+        double t0 = NowMs();
+        fn();
+        double elapsed = NowMs() - t0;
+        totalMs += elapsed;
+        if (elapsed < minMs) minMs = elapsed;
+    }
+    double avgMs = totalMs / iterations;
+    if (bytesPerIter > 0) {
+        double mbPerSec = ((double)bytesPerIter / (1024.0 * 1024.0)) / (minMs / 1000.0);
+        printf("%-42s %4d iter  avg %9.3f ms  min %9.3f ms  %8.1f MB/s\n",
+               name, iterations, avgMs, minMs, mbPerSec);
+    } else {
+        printf("%-42s %4d iter  avg %9.3f ms  min %9.3f ms\n",
+               name, iterations, avgMs, minMs);
+    }
+}
+
+// ===================== Synthetic data =====================
+
+// Message text giống hội thoại thật: trộn câu ngắn và đoạn dài nhiều dòng
+std::wstring MakeMessageText(int seed) {
+    static const wchar_t* fragments[] = {
+        L"Xin chào, bạn có thể giải thích đoạn code này không?",
+        L"The quick brown fox jumps over the lazy dog. ",
+        L"Dưới đây là các bước cần làm để cấu hình backend:\n",
+        L"1. Mở file config.json và sửa baseUrl.\n2. Khởi động lại service.\n",
+        L"This response contains a longer explanation of the behavior "
+        L"observed in the renderer, including wrap-around measurement. ",
+    };
+    std::wstring text;
+    int parts = 2 + (seed % 7);
+    for (int i = 0; i < parts; i++) {
+        text += fragments[(seed + i) % 5];
+    }
+    return text;
+}
+
+std::vector<ChatMessage> MakeTranscript(int count) {
+    std::vector<ChatMessage> messages;
+    messages.reserve(count);
+    for (int i = 0; i < count; i++) {
+        ChatMessage msg;
+        msg.text = MakeMessageText(i);
+        msg.isUser = (i % 2 == 0);
+        msg.type = msg.isUser ? MessageType::User : MessageType::AI;
+        msg.timestamp = L"2026-01-15T10:30:00";
+        messages.push_back(std::move(msg));
+    }
+    return messages;
+}
+
+// Payload dạng /conversations: mảng object giống backend trả về,
+// lặp cho tới khi đạt cỡ targetBytes
+std::string MakeConversationPayload(size_t targetBytes) {
+    std::ostringstream oss;
+    oss << "[";
+    bool first = true;
+    int i = 0;
+    while ((size_t)oss.tellp() < targetBytes) {
+        if (!first) oss << ",";
+        first = false;
+        oss << "{\"session_id\":\"session_" << i
+            << "\",\"user_message\":\"" << "How do I configure the renderer backend option number " << i
+            << "?\",\"ai_response\":\"" << "You can set the renderBackend key in the configuration file. "
+               "This answer is intentionally padded to resemble a realistic response body with "
+               "enough prose that the parser spends its time in string handling rather than "
+               "structural tokens. Iteration " << i
+            << "\",\"created_at\":\"2026-01-15T10:30:00\",\"token_usage\":" << (100 + i % 900)
+            << ",\"latency_ms\":" << (200 + i % 1800) << "}";
+        i++;
+    }
+    oss << "]";
+    return oss.str();
+}
+
+std::wstring TempFilePath(const wchar_t* name) {
+    wchar_t tempDir[MAX_PATH] = L".\\";
+    GetTempPathW(MAX_PATH, tempDir);
+    return std::wstring(tempDir) + name;
+}
+
+// ===================== Benchmarks =====================
+
+// Layout/measure như EnsureMessageLayout: DrawTextW DT_CALCRECT qua
+// GDIResourceManager::MeasureText với wrap width cố định. Đo cả hai chiều:
+// cache lạnh (ClearCache mỗi vòng - chi phí đo thật) và cache nóng
+// (đường đi per-frame sau khi layout đã ổn định).
+void BenchMessageLayout(const std::vector<ChatMessage>& messages) {
+    GDIResourceManager gdiManager;
+    HDC hdc = GetDC(NULL);
+    auto font = gdiManager.CreateFont(
+        -16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+        DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+        CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+    const int wrapWidth = 560;
+
+    RunBench("layout: MeasureText cold (1k messages)", 20, 0, [&]() {
+        gdiManager.ClearCache();
+        for (const auto& msg : messages) {
+            gdiManager.MeasureText(hdc, font->Get(), msg.text, wrapWidth,
+                                   DT_LEFT | DT_WORDBREAK);
+        }
+    });
+    RunBench("layout: MeasureText warm (1k messages)", 200, 0, [&]() {
+        for (const auto& msg : messages) {
+            gdiManager.MeasureText(hdc, font->Get(), msg.text, wrapWidth,
+                                   DT_LEFT | DT_WORDBREAK);
+        }
+    });
+
+    ReleaseDC(NULL, hdc);
+}
+
+void BenchParseArray() {
+    static const size_t sizesMb[] = {1, 8, 32};
+    for (size_t mb : sizesMb) {
+        std::string payload = MakeConversationPayload(mb * 1024 * 1024);
+        char name[64];
+        int iterations = (mb >= 32) ? 3 : 10;
+
+        snprintf(name, sizeof(name), "parse: JsonParser::ParseArray %zuMB", mb);
+        RunBench(name, iterations, payload.size(), [&]() {
+            auto items = JsonParser::ParseArray(payload);
+            if (items.empty()) {
+                printf("  !! ParseArray returned empty result\n");
+            }
+        });
+
+        // SAX path như MergeConversationsPage: chỉ rút 4 field mỗi element,
+        // không DOM trung gian
+        snprintf(name, sizeof(name), "parse: JsonParser::StreamArray %zuMB", mb);
+        RunBench(name, iterations, payload.size(), [&]() {
+            size_t count = 0;
+            std::string sessionId, userMessage, createdAt;
+            long long id = 0;
+            JsonParser::StreamArrayCallbacks cb;
+            cb.onString = [&](const std::string& key, const std::string& value) {
+                if (key == "session_id") sessionId = value;
+                else if (key == "user_message") userMessage = value;
+                else if (key == "created_at") createdAt = value;
+            };
+            cb.onInt = [&](const std::string& key, long long value) {
+                if (key == "id") id = value;
+            };
+            cb.onElementEnd = [&]() { count++; return true; };
+            if (!JsonParser::StreamArray(payload, cb) || count == 0) {
+                printf("  !! StreamArray returned no elements\n");
+            }
+        });
+    }
+}
+
+void BenchSearch(const std::vector<ChatMessage>& messages) {
+    SearchIndex index;
+    size_t totalChars = 0;
+    for (const auto& msg : messages) totalChars += msg.text.length();
+
+    char name[64];
+    snprintf(name, sizeof(name), "search: index build (%zu msgs)", messages.size());
+    RunBench(name, 20, totalChars * sizeof(wchar_t), [&]() {
+        index.Clear();
+        for (size_t i = 0; i < messages.size(); i++) {
+            index.SyncEntry(i, messages[i].text);
+        }
+    });
+
+    // Query như người dùng gõ trong search bar: một từ có trong transcript
+    std::wstring folded = SearchIndex::FoldText(L"renderer");
+    RunBench("search: FindMatchingEntries (trigram)", 500, 0, [&]() {
+        auto results = index.FindMatchingEntries(folded);
+        (void)results;
+    });
+
+    // Query ngắn <3 ký tự đi đường fallback scan tuyến tính
+    std::wstring shortFolded = SearchIndex::FoldText(L"ab");
+    RunBench("search: FindMatchingEntries (short scan)", 100, 0, [&]() {
+        auto results = index.FindMatchingEntries(shortFolded);
+        (void)results;
+    });
+}
+
+void BenchExport(const std::vector<ChatMessage>& messages) {
+    struct { ExportFormat format; const char* label; const wchar_t* file; } cases[] = {
+        {ExportFormat::TXT,      "export: TXT",      L"senai_bench_export.txt"},
+        {ExportFormat::Markdown, "export: Markdown", L"senai_bench_export.md"},
+        {ExportFormat::JSON,     "export: JSON",     L"senai_bench_export.json"},
+    };
+    for (const auto& c : cases) {
+        std::wstring path = TempFilePath(c.file);
+        char name[64];
+        snprintf(name, sizeof(name), "%s (%zu msgs)", c.label, messages.size());
+        RunBench(name, 10, 0, [&]() {
+            if (!ExportService::ExportConversations(messages, "bench_session",
+                                                    path, c.format, L"bench-model")) {
+                printf("  !! export failed: %s\n", c.label);
+            }
+        });
+        DeleteFileW(path.c_str());
+    }
+}
+
+} // namespace
+
+int main() {
+    printf("SenAIFrontendBench - frontend hot path microbenchmarks\n");
+    printf("(per-iteration timing; compare min across releases)\n\n");
+
+    auto smallTranscript = MakeTranscript(1000);   // cỡ layout per-frame
+    auto largeTranscript = MakeTranscript(20000);  // cỡ search transcript lớn
+
+    BenchMessageLayout(smallTranscript);
+    BenchParseArray();
+    BenchSearch(largeTranscript);
+    BenchExport(smallTranscript);
+
+    printf("\ndone.\n");
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include "ConversationCache.h"
+#include "MainWindowHelpers.h"
+#include "../ui/MainWindow.h"
+#include <windows.h>
+#include <fstream>
+#include <cstring>
+
+namespace {
+
+// 'SAC1' - đổi magic/version khi format thay đổi để cache cũ thành cache miss
+const unsigned int CACHE_MAGIC = 0x31434153;
+// v2: conversation entry lưu rawUserMessage/rawCreatedAt (UTF-8) thay vì
+// preview/timestamp đã format - sidebar format lazy khi row hiện ra
+const unsigned int CACHE_VERSION = 2;
+
+// Reader bounds-checked trên vùng file đã map: mọi Read* đều kiểm tra
+// còn đủ byte trước khi chạm vào, file cụt -> fail thay vì đọc lố
+struct MappedReader {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    bool failed = false;
+
+    bool Remaining(size_t count) {
+        if (failed || pos + count > size || pos + count < pos) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    unsigned int ReadU32() {
+        unsigned int value = 0;
+        if (Remaining(sizeof(value))) {
+            std::memcpy(&value, data + pos, sizeof(value));
+            pos += sizeof(value);
+        }
+        return value;
+    }
+
+    int ReadI32() {
+        return static_cast<int>(ReadU32());
+    }
+
+    unsigned char ReadU8() {
+        unsigned char value = 0;
+        if (Remaining(1)) {
+            value = data[pos];
+            pos += 1;
+        }
+        return value;
+    }
+
+    std::string ReadString() {
+        unsigned int len = ReadU32();
+        std::string value;
+        if (Remaining(len)) {
+            value.assign(reinterpret_cast<const char*>(data + pos), len);
+            pos += len;
+        }
+        return value;
+    }
+
+    std::wstring ReadWString() {
+        unsigned int len = ReadU32(); // số wchar_t, không phải byte
+        std::wstring value;
+        size_t bytes = static_cast<size_t>(len) * sizeof(wchar_t);
+        if (Remaining(bytes)) {
+            value.resize(len);
+            if (len > 0) {
+                std::memcpy(&value[0], data + pos, bytes);
+            }
+            pos += bytes;
+        }
+        return value;
+    }
+};
+
+// Writer gom vào buffer rồi ghi một lần (cache nhỏ, không cần stream)
+struct CacheWriter {
+    std::string buffer;
+
+    void WriteU32(unsigned int value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteI32(int value) {
+        WriteU32(static_cast<unsigned int>(value));
+    }
+
+    void WriteU8(unsigned char value) {
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void WriteString(const std::string& value) {
+        WriteU32(static_cast<unsigned int>(value.length()));
+        buffer.append(value);
+    }
+
+    void WriteWString(const std::wstring& value) {
+        WriteU32(static_cast<unsigned int>(value.length()));
+        buffer.append(reinterpret_cast<const char*>(value.data()),
+                      value.length() * sizeof(wchar_t));
+    }
+};
+
+} // namespace
+
+std::string ConversationCache::GetCachePath(const std::string& configPath) {
+    // senai_frontend.config.json -> senai_frontend.cache.bin (cùng thư mục)
+    size_t pos = configPath.find_last_of("\\/");
+    std::string dir = (pos == std::string::npos) ? "" : configPath.substr(0, pos + 1);
+    return dir + "senai_frontend.cache.bin";
+}
+
+bool ConversationCache::Load(
+    const std::string& cachePath,
+    std::vector<ConversationInfo>& conversations,
+    int& newestConversationId,
+    std::string& lastSessionId,
+    std::vector<ChatMessage>& messages) {
+
+    HANDLE hFile = CreateFileA(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false; // Chưa có cache (lần chạy đầu)
+    }
+
+    LARGE_INTEGER fileSize = {0};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0 ||
+        fileSize.QuadPart > (64LL * 1024 * 1024)) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!hMapping) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    MappedReader reader;
+    reader.data = static_cast<const unsigned char*>(view);
+    reader.size = static_cast<size_t>(fileSize.QuadPart);
+
+    bool ok = false;
+    std::vector<ConversationInfo> loadedConversations;
+    std::vector<ChatMessage> loadedMessages;
+    int loadedNewestId = 0;
+    std::string loadedSessionId;
+
+    if (reader.ReadU32() == CACHE_MAGIC && reader.ReadU32() == CACHE_VERSION) {
+        loadedNewestId = reader.ReadI32();
+        loadedSessionId = reader.ReadString();
+
+        unsigned int convCount = reader.ReadU32();
+        for (unsigned int i = 0; i < convCount && !reader.failed; ++i) {
+            ConversationInfo info;
+            info.id = reader.ReadI32();
+            info.rawSessionId = reader.ReadString();
+            info.sessionId = Utf8ToWide(info.rawSessionId);
+            info.rawUserMessage = reader.ReadString();
+            info.rawCreatedAt = reader.ReadString();
+            loadedConversations.push_back(info);
+        }
+
+        unsigned int msgCount = reader.ReadU32();
+        for (unsigned int i = 0; i < msgCount && !reader.failed; ++i) {
+            ChatMessage msg;
+            unsigned char type = reader.ReadU8();
+            msg.type = (type <= static_cast<unsigned char>(MessageType::Code))
+                           ? static_cast<MessageType>(type)
+                           : MessageType::AI;
+            msg.isUser = (msg.type == MessageType::User);
+            msg.text = reader.ReadWString();
+            msg.timestamp = reader.ReadWString();
+            loadedMessages.push_back(msg);
+        }
+
+        ok = !reader.failed;
+    }
+
+    UnmapViewOfFile(view);
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+
+    if (!ok) {
+        return false;
+    }
+
+    conversations = std::move(loadedConversations);
+    newestConversationId = loadedNewestId;
+    lastSessionId = std::move(loadedSessionId);
+    messages = std::move(loadedMessages);
+    return true;
+}
+
+bool ConversationCache::Save(
+    const std::string& cachePath,
+    const std::vector<ConversationInfo>& conversations,
+    int newestConversationId,
+    const std::string& lastSessionId,
+    const std::vector<ChatMessage>& messages) {
+
+    CacheWriter writer;
+    writer.WriteU32(CACHE_MAGIC);
+    writer.WriteU32(CACHE_VERSION);
+    writer.WriteI32(newestConversationId);
+    writer.WriteString(lastSessionId);
+
+    writer.WriteU32(static_cast<unsigned int>(conversations.size()));
+    for (const auto& info : conversations) {
+        writer.WriteI32(info.id);
+        writer.WriteString(info.rawSessionId);
+        writer.WriteString(info.rawUserMessage);
+        writer.WriteString(info.rawCreatedAt);
+    }
+
+    writer.WriteU32(static_cast<unsigned int>(messages.size()));
+    for (const auto& msg : messages) {
+        writer.WriteU8(static_cast<unsigned char>(msg.type));
+        writer.WriteWString(msg.text);
+        writer.WriteWString(msg.timestamp);
+    }
+
+    // Ghi ra file tạm rồi thay thế - cache cũ còn nguyên nếu ghi dở
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(writer.buffer.data(), writer.buffer.size());
+        out.close();
+        if (!out.good()) {
+            DeleteFileA(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (!MoveFileExA(tmpPath.c_str(), cachePath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Forward declare types that are defined in MainWindow.h
+struct ConversationInfo;
+struct ChatMessage;
+
+/**
+ * ConversationCache - On-disk cache cho cold startup
+ *
+ * Mỗi lần khởi động, UI trống cho tới khi RefreshConversations và
+ * LoadConversationBySessionId round-trip xong với backend. Cache này lưu
+ * danh sách sidebar + transcript của session mở gần nhất vào một file nhị
+ * phân compact cạnh senai_frontend.config.json; lúc khởi động file được
+ * memory-map và đọc thẳng, nên UI vẽ được dữ liệu cũ trong vài chục ms
+ * rồi mới đối chiếu với backend (delta refresh qua newestConversationId).
+ *
+ * File hỏng/cụt/sai version được coi là cache miss (Load trả false) -
+ * mọi record đều được bounds-check trước khi đọc. Save ghi ra file .tmp
+ * rồi MoveFileEx đè lên, nên cache cũ còn nguyên nếu ghi dở.
+ */
+class ConversationCache {
+public:
+    // Đường dẫn file cache, đặt cạnh file config (cùng thư mục exe)
+    static std::string GetCachePath(const std::string& configPath);
+
+    // Đọc cache từ disk (memory-mapped). Trả false nếu chưa có cache
+    // hoặc file không hợp lệ - caller giữ nguyên trạng thái hiện tại.
+    static bool Load(
+        const std::string& cachePath,
+        std::vector<ConversationInfo>& conversations,
+        int& newestConversationId,
+        std::string& lastSessionId,
+        std::vector<ChatMessage>& messages
+    );
+
+    // Ghi đè cache với snapshot hiện tại (sidebar + transcript đang mở)
+    static bool Save(
+        const std::string& cachePath,
+        const std::vector<ConversationInfo>& conversations,
+        int newestConversationId,
+        const std::string& lastSessionId,
+        const std::vector<ChatMessage>& messages
+    );
+};
@@ -15,6 +15,18 @@ ErrorHandler& ErrorHandler::GetInstance() {
 ErrorHandler::ErrorHandler() : logFilePathInitialized_(false) {
     // Initialize log file path
     GetLogFilePathInternal();
+    logFlusher_ = std::thread(&ErrorHandler::FlusherLoop, this);
+}
+
+ErrorHandler::~ErrorHandler() {
+    {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        logStopping_ = true;
+    }
+    logCv_.notify_one();
+    if (logFlusher_.joinable()) {
+        logFlusher_.join(); // FlusherLoop drain nốt queue trước khi thoát
+    }
 }
 
 std::string ErrorHandler::GetLogFilePathInternal() const {
@@ -74,10 +86,60 @@ std::string ErrorHandler::GetSeverityString(ErrorSeverity severity) {
 }
 
 void ErrorHandler::WriteToLog(const std::string& logEntry) {
+    // Chỉ enqueue vào ring buffer - file I/O do FlusherLoop lo.
+    // Buffer đầy (burst lỗi liên tục) thì drop entry mới thay vì chặn
+    // calling thread; số drop được báo lại ở lần flush kế tiếp.
+    {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        if (logQueued_ >= LOG_RING_CAPACITY) {
+            logDropped_++;
+            return;
+        }
+        logRing_[(logReadPos_ + logQueued_) % LOG_RING_CAPACITY] = logEntry;
+        logQueued_++;
+    }
+    logCv_.notify_one();
+}
+
+void ErrorHandler::FlusherLoop() {
+    // File handle mở một lần và giữ suốt vòng đời - không open/close mỗi entry
     std::ofstream out(GetLogFilePathInternal(), std::ios::app);
-    if (out.is_open()) {
-        out << logEntry << "\n";
-        out.flush();
+
+    std::vector<std::string> batch;
+    batch.reserve(64);
+
+    for (;;) {
+        size_t dropped = 0;
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(logMutex_);
+            logCv_.wait(lock, [this] { return logQueued_ > 0 || logStopping_; });
+
+            while (logQueued_ > 0) {
+                batch.push_back(std::move(logRing_[logReadPos_]));
+                logReadPos_ = (logReadPos_ + 1) % LOG_RING_CAPACITY;
+                logQueued_--;
+            }
+            dropped = logDropped_;
+            logDropped_ = 0;
+            stopping = logStopping_;
+        }
+
+        if (out.is_open()) {
+            for (const auto& entry : batch) {
+                out << entry << "\n";
+            }
+            if (dropped > 0) {
+                out << "[" << GetTimestamp() << "] [WARN] [SYSTEM] "
+                    << dropped << " log entries dropped (ring buffer full)\n";
+            }
+            out.flush(); // Một lần mỗi batch thay vì mỗi entry
+        }
+        batch.clear();
+
+        if (stopping) {
+            return;
+        }
     }
 }
 
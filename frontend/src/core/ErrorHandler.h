@@ -2,6 +2,10 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <windows.h>
 
 /**
@@ -121,19 +125,35 @@ public:
     
 private:
     ErrorHandler();
-    ~ErrorHandler() = default;
+    ~ErrorHandler();
     ErrorHandler(const ErrorHandler&) = delete;
     ErrorHandler& operator=(const ErrorHandler&) = delete;
-    
+
     void WriteToLog(const std::string& logEntry);
+    void FlusherLoop();
     std::string GetTimestamp();
     std::string GetCategoryString(ErrorCategory category);
     std::string GetSeverityString(ErrorSeverity severity);
     std::string GetLogFilePathInternal() const;
-    
+
     std::function<void(const ErrorInfo&)> errorCallback_;
     std::string logFilePath_;
     bool logFilePathInitialized_;
+
+    // Async log pipeline: WriteToLog chỉ đẩy entry vào ring buffer dưới
+    // mutex (vài trăm ns) thay vì open/write/close file trên calling thread
+    // - LogError chạy từ HTTP retry path và cả UI thread. Flusher thread
+    // giữ file handle mở và drain theo batch; buffer đầy thì drop entry
+    // mới và ghi một dòng đếm số entry bị drop (bounded-drop khi burst).
+    static constexpr size_t LOG_RING_CAPACITY = 1024;
+    std::array<std::string, LOG_RING_CAPACITY> logRing_;
+    size_t logReadPos_ = 0;     // Vị trí entry cũ nhất chưa flush
+    size_t logQueued_ = 0;      // Số entry đang chờ flush
+    size_t logDropped_ = 0;     // Số entry bị drop từ lần flush trước
+    std::mutex logMutex_;
+    std::condition_variable logCv_;
+    std::thread logFlusher_;
+    bool logStopping_ = false;
 };
 
 // Convenience macros for easier error logging
@@ -2,13 +2,94 @@
 #include "MainWindowHelpers.h"
 #include "JsonParser.h"
 #include "HttpClient.h"
+#include "TaskScheduler.h"
 #include "../ui/MainWindow.h"
+#include <condition_variable>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 
+namespace {
+
+// Build một message object JSON (nhỏ, sống ngắn) - escaping do nlohmann lo
+nlohmann::json MessageToJson(const ChatMessage& msg) {
+    nlohmann::json msgJson;
+    msgJson["text"] = WideToUtf8(msg.text);
+    msgJson["type"] = (msg.type == MessageType::User || msg.isUser) ? "user" : "ai";
+    msgJson["timestamp"] = WideToUtf8(msg.timestamp);
+
+    if (msg.metadata.tokenUsage > 0 || msg.metadata.latencyMs > 0 || !msg.metadata.modelName.empty()) {
+        msgJson["metadata"] = nlohmann::json::object();
+        if (msg.metadata.tokenUsage > 0) {
+            msgJson["metadata"]["token_usage"] = msg.metadata.tokenUsage;
+        }
+        if (msg.metadata.latencyMs > 0) {
+            msgJson["metadata"]["latency_ms"] = msg.metadata.latencyMs;
+        }
+        if (!msg.metadata.modelName.empty()) {
+            msgJson["metadata"]["model"] = WideToUtf8(msg.metadata.modelName);
+        }
+    }
+    return msgJson;
+}
+
+} // namespace
+
+// Giữ một chunk UTF-8 cố định và flush ra file khi đầy - bộ nhớ export
+// không phụ thuộc số lượng conversation
+class ExportService::BufferedFileWriter {
+public:
+    // Memory mode: không có file, buffer giữ toàn bộ nội dung - dùng cho
+    // worker convert một session thành chunk rồi TakeBuffer()
+    BufferedFileWriter() : toFile_(false) {}
+
+    explicit BufferedFileWriter(const std::wstring& filePath)
+        : file_(WideToUtf8(filePath), std::ios::out | std::ios::binary), toFile_(true) {
+        buffer_.reserve(FLUSH_THRESHOLD + 4096);
+    }
+
+    bool IsOpen() const { return !toFile_ || file_.is_open(); }
+
+    void Write(const std::wstring& text) {
+        Write(WideToUtf8(text));
+    }
+
+    void Write(const std::string& utf8) {
+        buffer_.append(utf8);
+        if (toFile_ && buffer_.size() >= FLUSH_THRESHOLD) {
+            FlushBuffer();
+        }
+    }
+
+    // Flush phần còn lại và đóng file; false nếu có lỗi ghi
+    bool Finish() {
+        FlushBuffer();
+        file_.close();
+        return file_.good();
+    }
+
+    // Memory mode: lấy nội dung đã gom (move, writer rỗng sau đó)
+    std::string TakeBuffer() { return std::move(buffer_); }
+
+private:
+    static const size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    void FlushBuffer() {
+        if (!buffer_.empty()) {
+            file_.write(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+    }
+
+    std::ofstream file_;
+    std::string buffer_;
+    bool toFile_ = true;
+};
+
 bool ExportService::ExportConversations(
     const std::vector<ChatMessage>& messages,
     const std::string& sessionId,
@@ -19,191 +100,250 @@ bool ExportService::ExportConversations(
     if (messages.empty()) {
         return false;
     }
-    
-    std::wstring content;
+
+    BufferedFileWriter out(filePath);
+    if (!out.IsOpen()) {
+        return false;
+    }
+
     switch (format) {
         case ExportFormat::TXT:
-            content = ConvertToTXT(messages, sessionId, modelName);
+            WriteTXT(out, messages, sessionId, modelName, true);
             break;
         case ExportFormat::Markdown:
-            content = ConvertToMarkdown(messages, sessionId, modelName);
+            WriteMarkdown(out, messages, sessionId, modelName, true);
             break;
         case ExportFormat::JSON:
-            content = ConvertToJSON(messages, sessionId, modelName);
+            WriteJSON(out, messages, sessionId, modelName);
             break;
         default:
             return false;
     }
-    
-    return WriteFile(filePath, content);
+
+    return out.Finish();
 }
 
 bool ExportService::ExportAllConversations(
     HttpClient& httpClient,
     const std::wstring& filePath,
     ExportFormat format,
-    const std::wstring& modelName) {
-    
-    // Get all conversations from backend
-    std::string conversationsJson = httpClient.getConversations("");
-    
-    if (conversationsJson.empty() || conversationsJson.find("Error:") == 0) {
-        return false;
-    }
-    
-    // Parse conversations
-    std::vector<nlohmann::json> conversationsArray = JsonParser::ParseArray(conversationsJson);
-    if (conversationsArray.empty()) {
-        return false;
-    }
-    
+    const std::wstring& modelName,
+    const ProgressCallback& progress) {
+
+    // ======= Giai đoạn 1: fetch theo page, pipeline với parse =======
+    // Page kế tiếp luôn được fetch trên một worker của TaskScheduler trong
+    // lúc thread này parse page hiện tại - thời gian mạng và parse chồng
+    // lên nhau thay vì cộng dồn. Cái giá là request cuối cùng over-fetch
+    // một page rỗng (không biết page trước có phải cuối không cho tới khi
+    // parse xong) - một request rẻ, chấp nhận được.
+    const int PAGE_SIZE = 500;
+
+    // Slot trao kết quả một page giữa worker fetch và thread này.
+    // shared_ptr vì worker có thể sống lâu hơn vòng lặp (page rỗng cuối)
+    struct PageSlot {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool ready = false;
+        std::string body;
+    };
+
+    auto fetchPageAsync = [&httpClient](int skip, std::shared_ptr<PageSlot> slot) {
+        TaskScheduler::GetInstance().Post(TaskPriority::UserBlocking,
+            [&httpClient, skip, slot]() {
+                std::string body = httpClient.getConversations("", skip, PAGE_SIZE);
+                std::lock_guard<std::mutex> lock(slot->mutex);
+                slot->body = std::move(body);
+                slot->ready = true;
+                slot->cv.notify_one();
+            });
+    };
+
     // Group by session_id and convert to ChatMessage format
     std::map<std::string, std::vector<ChatMessage>> sessionMessages;
-    
-    try {
-        for (const auto& conv : conversationsArray) {
-            if (!conv.is_object()) {
-                continue;
-            }
-            
-            std::string sessionId;
-            if (conv.contains("session_id") && conv["session_id"].is_string()) {
-                sessionId = conv["session_id"].get<std::string>();
-            }
-            
+    size_t totalConversations = 0;
+
+    auto slot = std::make_shared<PageSlot>();
+    fetchPageAsync(0, slot);
+    int skip = 0;
+    bool morePages = true;
+
+    while (morePages) {
+        std::string body;
+        {
+            std::unique_lock<std::mutex> lock(slot->mutex);
+            slot->cv.wait(lock, [&]() { return slot->ready; });
+            body = std::move(slot->body);
+        }
+        if (body.empty() || body.find("Error:") == 0) {
+            return false; // Chưa ghi byte nào ra file nên không có file cụt
+        }
+
+        // Prefetch page kế TRƯỚC khi parse page này
+        skip += PAGE_SIZE;
+        auto nextSlot = std::make_shared<PageSlot>();
+        fetchPageAsync(skip, nextSlot);
+
+        // SAX qua body - chỉ cần 4 field scalar mỗi element, không DOM
+        size_t pageCount = 0;
+        std::string sessionId, userMsg, aiMsg, createdAt;
+        JsonParser::StreamArrayCallbacks cb;
+        cb.onElementStart = [&]() {
+            sessionId.clear();
+            userMsg.clear();
+            aiMsg.clear();
+            createdAt.clear();
+        };
+        cb.onString = [&](const std::string& key, const std::string& value) {
+            if (key == "session_id") sessionId = value;
+            else if (key == "user_message") userMsg = value;
+            else if (key == "ai_response") aiMsg = value;
+            else if (key == "created_at") createdAt = value;
+        };
+        cb.onElementEnd = [&]() {
+            pageCount++;
+
             if (sessionId.empty()) {
                 sessionId = "unknown";
             }
-            
-            std::string userMsg;
-            if (conv.contains("user_message") && conv["user_message"].is_string()) {
-                userMsg = conv["user_message"].get<std::string>();
-            }
-            
-            std::string aiMsg;
-            if (conv.contains("ai_response") && conv["ai_response"].is_string()) {
-                aiMsg = conv["ai_response"].get<std::string>();
-            }
-            
-            std::string createdAt;
-            if (conv.contains("created_at") && conv["created_at"].is_string()) {
-                createdAt = conv["created_at"].get<std::string>();
-            }
-            
-            // Create messages
+            std::vector<ChatMessage>& target = sessionMessages[sessionId];
+
             ChatMessage userMessage;
             userMessage.text = Utf8ToWide(userMsg);
             userMessage.type = MessageType::User;
             userMessage.isUser = true;
             userMessage.timestamp = Utf8ToWide(createdAt);
-            
-            sessionMessages[sessionId].push_back(userMessage);
-            
+            target.push_back(std::move(userMessage));
+
             if (!aiMsg.empty()) {
                 ChatMessage aiMessage;
                 aiMessage.text = Utf8ToWide(aiMsg);
                 aiMessage.type = MessageType::AI;
                 aiMessage.isUser = false;
                 aiMessage.timestamp = Utf8ToWide(createdAt);
-                
-                sessionMessages[sessionId].push_back(aiMessage);
+                target.push_back(std::move(aiMessage));
             }
+            return true;
+        };
+        if (!JsonParser::StreamArray(body, cb)) {
+            return false;
         }
-    } catch (const std::exception& e) {
+
+        totalConversations += pageCount;
+        if (progress) {
+            progress(totalConversations, 0);
+        }
+
+        morePages = (pageCount == static_cast<size_t>(PAGE_SIZE));
+        slot = nextSlot;
+    }
+
+    if (totalConversations == 0) {
         return false;
     }
-    
-    // Convert to export format
-    std::wstring content;
-    
-    if (format == ExportFormat::JSON) {
-        // For JSON, create a structured format with all sessions
-        nlohmann::json exportData;
-        exportData["export_info"] = nlohmann::json::object();
-        exportData["export_info"]["model"] = WideToUtf8(modelName);
-        exportData["export_info"]["export_date"] = ""; // Will be set by system
-        exportData["export_info"]["total_sessions"] = sessionMessages.size();
-        exportData["conversations"] = nlohmann::json::array();
-        
-        for (const auto& pair : sessionMessages) {
-            nlohmann::json sessionData;
-            sessionData["session_id"] = pair.first;
-            sessionData["messages"] = nlohmann::json::array();
-            
-            for (const auto& msg : pair.second) {
-                nlohmann::json msgJson;
-                msgJson["text"] = WideToUtf8(msg.text);
-                msgJson["type"] = (msg.type == MessageType::User) ? "user" : "ai";
-                msgJson["timestamp"] = WideToUtf8(msg.timestamp);
-                if (msg.metadata.tokenUsage > 0) {
-                    msgJson["metadata"] = nlohmann::json::object();
-                    msgJson["metadata"]["token_usage"] = msg.metadata.tokenUsage;
-                    msgJson["metadata"]["latency_ms"] = msg.metadata.latencyMs;
-                    if (!msg.metadata.modelName.empty()) {
-                        msgJson["metadata"]["model"] = WideToUtf8(msg.metadata.modelName);
-                    }
+
+    // ======= Giai đoạn 2: convert song song, ghi theo thứ tự =======
+    // Mỗi session format thành một chunk UTF-8 trên worker (memory-mode
+    // BufferedFileWriter); thread này chờ chunk theo index nên file ra
+    // đúng thứ tự dù các convert hoàn thành lộn xộn.
+    BufferedFileWriter out(filePath);
+    if (!out.IsOpen()) {
+        return false;
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<ChatMessage>>*> sessions;
+    sessions.reserve(sessionMessages.size());
+    for (const auto& pair : sessionMessages) {
+        sessions.push_back(&pair);
+    }
+
+    struct ChunkState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::string> chunks;
+        std::vector<bool> ready;
+    };
+    auto state = std::make_shared<ChunkState>();
+    state->chunks.resize(sessions.size());
+    state->ready.assign(sessions.size(), false);
+
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        const auto* pair = sessions[i];
+        int sessionNum = static_cast<int>(i) + 1;
+        // Capture modelName/sessionMessages by reference là an toàn: vòng
+        // ghi bên dưới chờ đủ mọi chunk trước khi hàm này return
+        TaskScheduler::GetInstance().Post(TaskPriority::UserBlocking,
+            [pair, sessionNum, format, &modelName, state, i]() {
+                BufferedFileWriter chunk;
+                if (format == ExportFormat::JSON) {
+                    chunk.Write("    {\n      \"session_id\": " + nlohmann::json(pair->first).dump() + ",\n");
+                    chunk.Write("      \"messages\": ");
+                    WriteJSONMessageArray(chunk, pair->second, 6);
+                    chunk.Write("\n    }");
+                } else if (format == ExportFormat::Markdown) {
+                    chunk.Write(L"## Session " + std::to_wstring(sessionNum) + L" (" + Utf8ToWide(pair->first) + L")\n\n");
+                    WriteMarkdown(chunk, pair->second, pair->first, modelName, false);
+                    chunk.Write(L"\n\n");
+                } else {
+                    chunk.Write(L"SESSION " + std::to_wstring(sessionNum) + L" (" + Utf8ToWide(pair->first) + L")\n");
+                    chunk.Write(L"----------------------------------------\n\n");
+                    WriteTXT(chunk, pair->second, pair->first, modelName, false);
+                    chunk.Write(L"\n\n");
                 }
-                sessionData["messages"].push_back(msgJson);
-            }
-            
-            exportData["conversations"].push_back(sessionData);
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->chunks[i] = chunk.TakeBuffer();
+                state->ready[i] = true;
+                state->cv.notify_all();
+            });
+    }
+
+    // Header chung (khung JSON ghi tay, từng message vẫn dump qua nlohmann)
+    if (format == ExportFormat::JSON) {
+        nlohmann::json exportInfo;
+        exportInfo["model"] = WideToUtf8(modelName);
+        exportInfo["export_date"] = ""; // Will be set by system
+        exportInfo["total_sessions"] = sessionMessages.size();
+
+        out.Write("{\n  \"export_info\": " + exportInfo.dump() + ",\n");
+        out.Write("  \"conversations\": [\n");
+    } else if (format == ExportFormat::Markdown) {
+        out.Write(L"# Tất cả cuộc trò chuyện\n\n");
+        if (!modelName.empty()) {
+            out.Write(L"**Model:** " + modelName + L"\n\n");
         }
-        
-        content = Utf8ToWide(exportData.dump(2));
+        out.Write(L"---\n\n");
     } else {
-        // For TXT and Markdown, combine all sessions
-        std::wstringstream ss;
-        
-        if (format == ExportFormat::Markdown) {
-            ss << L"# Tất cả cuộc trò chuyện\n\n";
-            if (!modelName.empty()) {
-                ss << L"**Model:** " << modelName << L"\n\n";
-            }
-            ss << L"---\n\n";
-        } else {
-            ss << L"TẤT CẢ CUỘC TRÒ CHUYỆN\n";
-            ss << L"====================\n\n";
-            if (!modelName.empty()) {
-                ss << L"Model: " << modelName << L"\n\n";
-            }
-            ss << L"----------------------------------------\n\n";
+        out.Write(L"TẤT CẢ CUỘC TRÒ CHUYỆN\n");
+        out.Write(L"====================\n\n");
+        if (!modelName.empty()) {
+            out.Write(L"Model: " + modelName + L"\n\n");
         }
-        
-        int sessionNum = 1;
-        for (const auto& pair : sessionMessages) {
-            if (format == ExportFormat::Markdown) {
-                ss << L"## Session " << sessionNum << L" (" << Utf8ToWide(pair.first) << L")\n\n";
-            } else {
-                ss << L"SESSION " << sessionNum << L" (" << Utf8ToWide(pair.first) << L")\n";
-                ss << L"----------------------------------------\n\n";
-            }
-            
-            std::wstring sessionContent;
-            if (format == ExportFormat::Markdown) {
-                sessionContent = ConvertToMarkdown(pair.second, pair.first, modelName);
-                // Remove header from session content
-                size_t pos = sessionContent.find(L"\n\n");
-                if (pos != std::wstring::npos) {
-                    sessionContent = sessionContent.substr(pos + 2);
-                }
-            } else {
-                sessionContent = ConvertToTXT(pair.second, pair.first, modelName);
-                // Remove header from session content
-                size_t pos = sessionContent.find(L"\n\n");
-                if (pos != std::wstring::npos) {
-                    sessionContent = sessionContent.substr(pos + 2);
-                }
-            }
-            
-            ss << sessionContent;
-            ss << L"\n\n";
-            sessionNum++;
+        out.Write(L"----------------------------------------\n\n");
+    }
+
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        std::string chunkText;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->cv.wait(lock, [&]() { return state->ready[i]; });
+            chunkText = std::move(state->chunks[i]);
+        }
+
+        if (format == ExportFormat::JSON && i > 0) {
+            out.Write(",\n");
+        }
+        out.Write(chunkText);
+
+        if (progress) {
+            progress(totalConversations, i + 1);
         }
-        
-        content = ss.str();
     }
-    
-    return WriteFile(filePath, content);
+
+    if (format == ExportFormat::JSON) {
+        out.Write("\n  ]\n}");
+    }
+
+    return out.Finish();
 }
 
 std::wstring ExportService::GetFileExtension(ExportFormat format) {
@@ -236,167 +376,146 @@ std::wstring ExportService::GetAllFormatFilters() {
     return L"Text Files (*.txt)\0*.txt\0Markdown Files (*.md)\0*.md\0JSON Files (*.json)\0*.json\0All Files (*.*)\0*.*\0";
 }
 
-std::wstring ExportService::ConvertToTXT(
+void ExportService::WriteTXT(
+    BufferedFileWriter& out,
     const std::vector<ChatMessage>& messages,
     const std::string& sessionId,
-    const std::wstring& modelName) {
-    
-    std::wstringstream ss;
-    
-    ss << L"CUỘC TRÒ CHUYỆN\n";
-    ss << L"===============\n\n";
-    
-    if (!modelName.empty()) {
-        ss << L"Model: " << modelName << L"\n";
+    const std::wstring& modelName,
+    bool includeHeader) {
+
+    if (includeHeader) {
+        out.Write(L"CUỘC TRÒ CHUYỆN\n");
+        out.Write(L"===============\n\n");
+
+        if (!modelName.empty()) {
+            out.Write(L"Model: " + modelName + L"\n");
+        }
     }
-    ss << L"Session ID: " << Utf8ToWide(sessionId) << L"\n";
-    ss << L"\n";
-    ss << L"----------------------------------------\n\n";
-    
+    out.Write(L"Session ID: " + Utf8ToWide(sessionId) + L"\n");
+    out.Write(L"\n");
+    out.Write(L"----------------------------------------\n\n");
+
     for (const auto& msg : messages) {
         std::wstring role = (msg.type == MessageType::User || msg.isUser) ? L"Bạn" : L"AI";
-        ss << L"[" << role << L"] ";
-        
+        out.Write(L"[" + role + L"] ");
+
         if (!msg.timestamp.empty()) {
-            ss << L"(" << FormatTimestamp(msg.timestamp) << L") ";
+            out.Write(L"(" + FormatTimestamp(msg.timestamp) + L") ");
         }
-        
-        ss << L"\n";
-        ss << msg.text;
-        ss << L"\n\n";
-        
+
+        out.Write(L"\n");
+        out.Write(msg.text);
+        out.Write(L"\n\n");
+
         // Add metadata if available
         if (msg.metadata.tokenUsage > 0 || msg.metadata.latencyMs > 0 || !msg.metadata.modelName.empty()) {
-            ss << L"  [Metadata: ";
+            out.Write(L"  [Metadata: ");
             bool hasMeta = false;
             if (msg.metadata.tokenUsage > 0) {
-                ss << L"Tokens=" << msg.metadata.tokenUsage;
+                out.Write(L"Tokens=" + std::to_wstring(msg.metadata.tokenUsage));
                 hasMeta = true;
             }
             if (msg.metadata.latencyMs > 0) {
-                if (hasMeta) ss << L", ";
-                ss << L"Latency=" << msg.metadata.latencyMs << L"ms";
+                if (hasMeta) out.Write(L", ");
+                out.Write(L"Latency=" + std::to_wstring(msg.metadata.latencyMs) + L"ms");
                 hasMeta = true;
             }
             if (!msg.metadata.modelName.empty()) {
-                if (hasMeta) ss << L", ";
-                ss << L"Model=" << msg.metadata.modelName;
+                if (hasMeta) out.Write(L", ");
+                out.Write(L"Model=" + msg.metadata.modelName);
             }
-            ss << L"]\n\n";
+            out.Write(L"]\n\n");
         }
     }
-    
-    return ss.str();
 }
 
-std::wstring ExportService::ConvertToMarkdown(
+void ExportService::WriteMarkdown(
+    BufferedFileWriter& out,
     const std::vector<ChatMessage>& messages,
     const std::string& sessionId,
-    const std::wstring& modelName) {
-    
-    std::wstringstream ss;
-    
-    ss << L"# Cuộc trò chuyện\n\n";
-    
-    if (!modelName.empty()) {
-        ss << L"**Model:** " << modelName << L"\n\n";
+    const std::wstring& modelName,
+    bool includeHeader) {
+
+    if (includeHeader) {
+        out.Write(L"# Cuộc trò chuyện\n\n");
+
+        if (!modelName.empty()) {
+            out.Write(L"**Model:** " + modelName + L"\n\n");
+        }
     }
-    ss << L"**Session ID:** `" << Utf8ToWide(sessionId) << L"`\n\n";
-    ss << L"---\n\n";
-    
+    out.Write(L"**Session ID:** `" + Utf8ToWide(sessionId) + L"`\n\n");
+    out.Write(L"---\n\n");
+
     for (const auto& msg : messages) {
         std::wstring role = (msg.type == MessageType::User || msg.isUser) ? L"**Bạn**" : L"**AI**";
-        ss << role;
-        
+        out.Write(role);
+
         if (!msg.timestamp.empty()) {
-            ss << L" *(" << FormatTimestamp(msg.timestamp) << L")*";
+            out.Write(L" *(" + FormatTimestamp(msg.timestamp) + L")*");
         }
-        
-        ss << L"\n\n";
-        
+
+        out.Write(L"\n\n");
+
         // Escape markdown special characters in message text
-        std::wstring escapedText = EscapeMarkdown(msg.text);
-        ss << escapedText;
-        ss << L"\n\n";
-        
+        out.Write(EscapeMarkdown(msg.text));
+        out.Write(L"\n\n");
+
         // Add metadata if available
         if (msg.metadata.tokenUsage > 0 || msg.metadata.latencyMs > 0 || !msg.metadata.modelName.empty()) {
-            ss << L"<small>";
+            out.Write(L"<small>");
             bool hasMeta = false;
             if (msg.metadata.tokenUsage > 0) {
-                ss << L"Tokens: " << msg.metadata.tokenUsage;
+                out.Write(L"Tokens: " + std::to_wstring(msg.metadata.tokenUsage));
                 hasMeta = true;
             }
             if (msg.metadata.latencyMs > 0) {
-                if (hasMeta) ss << L" | ";
-                ss << L"Latency: " << msg.metadata.latencyMs << L"ms";
+                if (hasMeta) out.Write(L" | ");
+                out.Write(L"Latency: " + std::to_wstring(msg.metadata.latencyMs) + L"ms");
                 hasMeta = true;
             }
             if (!msg.metadata.modelName.empty()) {
-                if (hasMeta) ss << L" | ";
-                ss << L"Model: " << msg.metadata.modelName;
+                if (hasMeta) out.Write(L" | ");
+                out.Write(L"Model: " + msg.metadata.modelName);
             }
-            ss << L"</small>\n\n";
+            out.Write(L"</small>\n\n");
         }
-        
-        ss << L"---\n\n";
+
+        out.Write(L"---\n\n");
     }
-    
-    return ss.str();
 }
 
-std::wstring ExportService::ConvertToJSON(
+void ExportService::WriteJSON(
+    BufferedFileWriter& out,
     const std::vector<ChatMessage>& messages,
     const std::string& sessionId,
     const std::wstring& modelName) {
-    
-    nlohmann::json exportData;
-    exportData["export_info"] = nlohmann::json::object();
-    exportData["export_info"]["model"] = WideToUtf8(modelName);
-    exportData["export_info"]["session_id"] = sessionId;
-    exportData["export_info"]["message_count"] = messages.size();
-    
-    exportData["messages"] = nlohmann::json::array();
-    
-    for (const auto& msg : messages) {
-        nlohmann::json msgJson;
-        msgJson["text"] = WideToUtf8(msg.text);
-        msgJson["type"] = (msg.type == MessageType::User || msg.isUser) ? "user" : "ai";
-        msgJson["timestamp"] = WideToUtf8(msg.timestamp);
-        
-        if (msg.metadata.tokenUsage > 0 || msg.metadata.latencyMs > 0 || !msg.metadata.modelName.empty()) {
-            msgJson["metadata"] = nlohmann::json::object();
-            if (msg.metadata.tokenUsage > 0) {
-                msgJson["metadata"]["token_usage"] = msg.metadata.tokenUsage;
-            }
-            if (msg.metadata.latencyMs > 0) {
-                msgJson["metadata"]["latency_ms"] = msg.metadata.latencyMs;
-            }
-            if (!msg.metadata.modelName.empty()) {
-                msgJson["metadata"]["model"] = WideToUtf8(msg.metadata.modelName);
-            }
-        }
-        
-        exportData["messages"].push_back(msgJson);
-    }
-    
-    return Utf8ToWide(exportData.dump(2));
+
+    nlohmann::json exportInfo;
+    exportInfo["model"] = WideToUtf8(modelName);
+    exportInfo["session_id"] = sessionId;
+    exportInfo["message_count"] = messages.size();
+
+    out.Write("{\n  \"export_info\": " + exportInfo.dump() + ",\n");
+    out.Write("  \"messages\": ");
+    WriteJSONMessageArray(out, messages, 2);
+    out.Write("\n}");
 }
 
-bool ExportService::WriteFile(const std::wstring& filePath, const std::wstring& content) {
-    // Convert wide string path to UTF-8 for file operations
-    std::string utf8Path = WideToUtf8(filePath);
-    std::ofstream file(utf8Path, std::ios::out | std::ios::binary);
-    if (!file.is_open()) {
-        return false;
+void ExportService::WriteJSONMessageArray(
+    BufferedFileWriter& out,
+    const std::vector<ChatMessage>& messages,
+    int indentLevel) {
+
+    std::string indent(static_cast<size_t>(indentLevel), ' ');
+    out.Write("[\n");
+
+    for (size_t i = 0; i < messages.size(); ++i) {
+        // Mỗi message một dòng, dump compact - chỉ message hiện tại nằm trong RAM
+        out.Write(indent + "  " + MessageToJson(messages[i]).dump());
+        out.Write(i + 1 < messages.size() ? ",\n" : "\n");
     }
-    
-    // Convert wide string content to UTF-8
-    std::string utf8Content = WideToUtf8(content);
-    file.write(utf8Content.c_str(), utf8Content.length());
-    file.close();
-    
-    return file.good();
+
+    out.Write(indent + "]");
 }
 
 std::wstring ExportService::FormatTimestamp(const std::wstring& timestamp) {
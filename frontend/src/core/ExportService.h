@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -35,12 +36,26 @@ public:
         const std::wstring& modelName = L""
     );
     
-    // Export all conversations from backend
+    // Tiến độ của export all: (số conversation đã fetch, số session đã ghi
+    // ra file). Gọi từ thread export - UI muốn hiển thị thì marshal qua
+    // PostMessageW, đừng đụng window state trực tiếp.
+    using ProgressCallback = std::function<void(size_t conversationsFetched,
+                                                size_t sessionsWritten)>;
+
+    // Export all conversations from backend.
+    //
+    // Chạy dạng pipeline thay vì một lượt tuần tự: page kế tiếp của GET
+    // /conversations được fetch trên worker trong lúc page hiện tại đang
+    // parse; sau đó mỗi session convert song song trên TaskScheduler và
+    // thread gọi hàm ghi các chunk ra file theo đúng thứ tự. Hàm vẫn
+    // blocking - caller muốn UI sống thì tự chạy nó trên thread riêng
+    // (xem ExportDlgProc).
     static bool ExportAllConversations(
         HttpClient& httpClient,
         const std::wstring& filePath,
         ExportFormat format,
-        const std::wstring& modelName = L""
+        const std::wstring& modelName = L"",
+        const ProgressCallback& progress = {}
     );
     
     // Get file extension for format
@@ -53,28 +68,42 @@ public:
     static std::wstring GetAllFormatFilters();
 
 private:
-    // Format converters
-    static std::wstring ConvertToTXT(
+    // Buffered streaming writer: nội dung export đi thẳng ra file theo chunk
+    // cố định thay vì gom cả document vào một wstring (định nghĩa trong .cpp)
+    class BufferedFileWriter;
+
+    // Format writers - stream từng message vào writer.
+    // includeHeader=false dùng cho export all (header chung đã ghi ở trên)
+    static void WriteTXT(
+        BufferedFileWriter& out,
         const std::vector<ChatMessage>& messages,
         const std::string& sessionId,
-        const std::wstring& modelName
+        const std::wstring& modelName,
+        bool includeHeader
     );
-    
-    static std::wstring ConvertToMarkdown(
+
+    static void WriteMarkdown(
+        BufferedFileWriter& out,
         const std::vector<ChatMessage>& messages,
         const std::string& sessionId,
-        const std::wstring& modelName
+        const std::wstring& modelName,
+        bool includeHeader
     );
-    
-    static std::wstring ConvertToJSON(
+
+    static void WriteJSON(
+        BufferedFileWriter& out,
         const std::vector<ChatMessage>& messages,
         const std::string& sessionId,
         const std::wstring& modelName
     );
-    
-    // Helper to write file
-    static bool WriteFile(const std::wstring& filePath, const std::wstring& content);
-    
+
+    // Ghi mảng JSON của messages, mỗi message một dòng (indentLevel khoảng trắng)
+    static void WriteJSONMessageArray(
+        BufferedFileWriter& out,
+        const std::vector<ChatMessage>& messages,
+        int indentLevel
+    );
+
     // Helper to format timestamp
     static std::wstring FormatTimestamp(const std::wstring& timestamp);
     
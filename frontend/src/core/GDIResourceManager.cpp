@@ -30,6 +30,25 @@ GDIPenPtr GDIResourceManager::CreatePen(int style, int width, COLORREF color) {
     return std::make_unique<GDIPen>(pen);
 }
 
+GDILayerPtr GDIResourceManager::CreateLayer(HDC hdcRef, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+
+    HDC dc = CreateCompatibleDC(hdcRef);
+    if (!dc) {
+        return nullptr;
+    }
+    HBITMAP bitmap = CreateCompatibleBitmap(hdcRef, width, height);
+    if (!bitmap) {
+        DeleteDC(dc);
+        return nullptr;
+    }
+    HBITMAP oldBitmap = (HBITMAP)SelectObject(dc, bitmap);
+
+    return std::make_unique<GDILayer>(dc, bitmap, oldBitmap, width, height);
+}
+
 GDIFontPtr GDIResourceManager::GetOrCreateFont(const std::string& /*key*/,
                                                  std::function<HFONT()> factory) {
     // Simply create from factory - caching not needed as fonts can't be shared
@@ -54,11 +73,112 @@ GDIPenPtr GDIResourceManager::GetOrCreatePen(const std::string& /*key*/,
     return std::make_unique<GDIPen>(pen);
 }
 
+std::wstring GDIResourceManager::MakeMeasureKey(HFONT font, int wrapWidth, UINT format,
+                                                const std::wstring& text) {
+    // Tham số đo đứng trước text để các chuỗi dài khác tham số khác nhau sớm
+    std::wstring key = std::to_wstring(reinterpret_cast<UINT_PTR>(font)) + L"|" +
+                       std::to_wstring(wrapWidth) + L"|" +
+                       std::to_wstring(format) + L"|";
+    key += text;
+    return key;
+}
+
+SIZE GDIResourceManager::MeasureText(HDC hdc, HFONT font, const std::wstring& text,
+                                     int wrapWidth, UINT format) {
+    std::wstring key = MakeMeasureKey(font, wrapWidth, format, text);
+
+    auto it = measureCache_.find(key);
+    if (it != measureCache_.end()) {
+        // Cache hit: đưa entry lên đầu LRU, không chạm GDI
+        measureLru_.splice(measureLru_.begin(), measureLru_, it->second.lruIt);
+        return it->second.size;
+    }
+
+    RECT rc = {0, 0, (wrapWidth > 0) ? wrapWidth : 0, 0};
+    HGDIOBJ oldFont = SelectObject(hdc, font);
+    DrawTextW(hdc, text.c_str(), -1, &rc, format | DT_CALCRECT);
+    SelectObject(hdc, oldFont);
+
+    SIZE size = {rc.right - rc.left, rc.bottom - rc.top};
+
+    if (measureCache_.size() >= MEASURE_CACHE_CAPACITY) {
+        measureCache_.erase(measureLru_.back());
+        measureLru_.pop_back();
+    }
+    measureLru_.push_front(std::move(key));
+    measureCache_[measureLru_.front()] = {size, measureLru_.begin()};
+    return size;
+}
+
+GDIResourceManager& GDIResourceManager::Shared() {
+    static GDIResourceManager instance;
+    return instance;
+}
+
+HFONT GDIResourceManager::GetFont(int height, int weight, const wchar_t* faceName, BOOL italic) {
+    std::string key = MakeFontKey(height, 0, weight, italic, faceName);
+    auto it = fontCache_.find(key);
+    if (it != fontCache_.end()) {
+        return it->second->Get();
+    }
+
+    HFONT font = CreateFontW(height, 0, 0, 0, weight, italic, FALSE, FALSE,
+                             DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+                             CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, faceName);
+    auto& slot = fontCache_[key];
+    slot = std::make_unique<GDIFont>(font);
+    return slot->Get();
+}
+
+HBRUSH GDIResourceManager::GetBrush(COLORREF color) {
+    std::string key = MakeBrushKey(color);
+    auto it = brushCache_.find(key);
+    if (it != brushCache_.end()) {
+        return it->second->Get();
+    }
+
+    auto& slot = brushCache_[key];
+    slot = std::make_unique<GDIBrush>(::CreateSolidBrush(color));
+    return slot->Get();
+}
+
+HPEN GDIResourceManager::GetPen(int style, int width, COLORREF color) {
+    std::string key = MakePenKey(style, width, color);
+    auto it = penCache_.find(key);
+    if (it != penCache_.end()) {
+        return it->second->Get();
+    }
+
+    auto& slot = penCache_[key];
+    slot = std::make_unique<GDIPen>(::CreatePen(style, width, color));
+    return slot->Get();
+}
+
+void GDIResourceManager::PrewarmCommonResources() {
+    // Bộ mà Settings/Export/ExitConfirm dùng trên đường paint đầu tiên.
+    // Màu/size phải khớp các dialog proc - thêm vào đây khi dialog mới
+    // dùng descriptor mới.
+    GetFont(-20, FW_SEMIBOLD, L"Segoe UI"); // Title dialog
+    GetFont(-16, FW_NORMAL, L"Segoe UI");   // Label / control text
+
+    GetBrush(RGB(16, 22, 40));   // Nền dialog
+    GetBrush(RGB(18, 24, 42));   // Nền edit / radio chưa chọn
+    GetBrush(RGB(25, 36, 64));   // Nền button
+    GetBrush(RGB(74, 215, 255)); // Accent (radio inner, icon)
+
+    GetPen(PS_SOLID, 1, RGB(74, 215, 255)); // Header line / accent border
+    GetPen(PS_SOLID, 1, RGB(60, 90, 130));  // Border button phụ / radio chưa chọn
+    GetPen(PS_SOLID, 2, RGB(74, 215, 255)); // Border input focus
+    GetPen(PS_SOLID, 2, RGB(255, 255, 255)); // Checkmark
+}
+
 void GDIResourceManager::ClearCache() {
-    // Clear cache (currently not used but kept for future use)
+    // Giải phóng mọi object cached (font/brush/pen qua smart pointer)
     fontCache_.clear();
     brushCache_.clear();
     penCache_.clear();
+    measureCache_.clear();
+    measureLru_.clear();
 }
 
 void GDIResourceManager::RemoveFont(const std::string& key) {
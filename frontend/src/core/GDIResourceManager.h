@@ -3,6 +3,7 @@
 #include <windows.h>
 #include <memory>
 #include <unordered_map>
+#include <list>
 #include <string>
 #include <functional>
 
@@ -17,11 +18,13 @@
 class GDIFont;
 class GDIBrush;
 class GDIPen;
+class GDILayer;
 
 // Smart pointer types
 using GDIFontPtr = std::unique_ptr<GDIFont>;
 using GDIBrushPtr = std::unique_ptr<GDIBrush>;
 using GDIPenPtr = std::unique_ptr<GDIPen>;
+using GDILayerPtr = std::unique_ptr<GDILayer>;
 
 /**
  * GDIFont - RAII wrapper for HFONT
@@ -131,11 +134,66 @@ private:
     HPEN pen_;
 };
 
+/**
+ * GDILayer - RAII wrapper for an offscreen layer (bitmap pre-selected
+ * into its own memory DC)
+ *
+ * Dùng cho các layer tĩnh vẽ một lần rồi composite lại mỗi frame bằng
+ * BitBlt/AlphaBlend. DC và bitmap được giải phóng cùng nhau.
+ */
+class GDILayer {
+public:
+    GDILayer(HDC dc, HBITMAP bitmap, HBITMAP oldBitmap, int width, int height)
+        : dc_(dc), bitmap_(bitmap), oldBitmap_(oldBitmap), width_(width), height_(height) {}
+    ~GDILayer() {
+        if (dc_) {
+            if (oldBitmap_) {
+                SelectObject(dc_, oldBitmap_);
+            }
+            DeleteDC(dc_);
+        }
+        if (bitmap_) {
+            DeleteObject(bitmap_);
+        }
+    }
+
+    // Non-copyable
+    GDILayer(const GDILayer&) = delete;
+    GDILayer& operator=(const GDILayer&) = delete;
+
+    HDC Dc() const { return dc_; }
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+private:
+    HDC dc_;
+    HBITMAP bitmap_;
+    HBITMAP oldBitmap_;
+    int width_;
+    int height_;
+};
+
 /**
  * GDIResourceManager - Centralized resource manager with caching
  */
 class GDIResourceManager {
 public:
+    /**
+     * Cache GDI process-wide dùng chung cho mọi dialog proc.
+     *
+     * MainWindow giữ font qua member GDIFontPtr, nhưng các dialog
+     * (Settings, Export, ExitConfirm...) trước đây tạo/hủy font, brush,
+     * pen trên mỗi WM_PAINT. Shared() trả về một instance sống suốt
+     * process: GetFont/GetBrush/GetPen cache theo logical descriptor
+     * (LOGFONT rút gọn / màu / style) và trả về HANDLE KHÔNG SỞ HỮU -
+     * caller tuyệt đối không DeleteObject. Tổng GDI handle count vì thế
+     * phẳng theo số descriptor khác nhau thay vì theo số lần mở dialog.
+     *
+     * Pre-warm bộ chung trong MainWindow::OnCreate (PrewarmCommonResources)
+     * để lần mở dialog đầu tiên không trả chi phí tạo object.
+     */
+    static GDIResourceManager& Shared();
+
     GDIResourceManager() = default;
     ~GDIResourceManager() {
         ClearCache();
@@ -188,6 +246,32 @@ public:
      * @return Smart pointer to pen
      */
     GDIPenPtr CreatePen(int style, int width, COLORREF color);
+
+    /**
+     * Create an offscreen layer (memory DC + bitmap) compatible with hdcRef
+     * @param hdcRef Reference DC (thường là DC của window)
+     * @param width Layer width in pixels
+     * @param height Layer height in pixels
+     * @return Smart pointer to layer, or nullptr on failure
+     */
+    GDILayerPtr CreateLayer(HDC hdcRef, int width, int height);
+
+    /**
+     * Measure text with memoization (DrawTextW DT_CALCRECT)
+     *
+     * Key = (font handle, wrap width, format, text); LRU eviction. Repaint
+     * một conversation không đổi hit cache 100% và không chạm GDI metrics.
+     *
+     * @param hdc DC dùng để đo khi cache miss
+     * @param font Font đo — CHỈ dùng với font sống lâu (hMessageFont_ v.v.);
+     *             handle của font tạm bị recycle có thể cho hit sai
+     * @param text Chuỗi cần đo
+     * @param wrapWidth Chiều rộng wrap (<= 0: đo không wrap)
+     * @param format Cờ DrawTextW (DT_CALCRECT được thêm tự động)
+     * @return Kích thước đo được (cx, cy)
+     */
+    SIZE MeasureText(HDC hdc, HFONT font, const std::wstring& text,
+                     int wrapWidth, UINT format);
     
     /**
      * Get cached font or create new one
@@ -215,7 +299,27 @@ public:
      */
     GDIPenPtr GetOrCreatePen(const std::string& key,
                               std::function<HPEN()> factory);
-    
+
+    /**
+     * Font cached theo descriptor (height/weight/italic/face); các tham số
+     * CreateFontW còn lại cố định theo convention của app (CLEARTYPE_QUALITY,
+     * DEFAULT_CHARSET...). Handle do cache sở hữu - KHÔNG DeleteObject.
+     */
+    HFONT GetFont(int height, int weight, const wchar_t* faceName, BOOL italic = FALSE);
+
+    /** Brush cached theo màu. Handle do cache sở hữu - KHÔNG DeleteObject. */
+    HBRUSH GetBrush(COLORREF color);
+
+    /** Pen cached theo (style, width, màu). Handle do cache sở hữu - KHÔNG DeleteObject. */
+    HPEN GetPen(int style, int width, COLORREF color);
+
+    /**
+     * Tạo trước bộ font/brush/pen mà các dialog dùng chung để lần mở
+     * dialog đầu tiên không stall trên GDI object creation.
+     */
+    void PrewarmCommonResources();
+
+
     /**
      * Clear all cached resources
      */
@@ -229,14 +333,26 @@ public:
     void RemovePen(const std::string& key);
     
 private:
-    // Cache structures kept for future use if needed
-    // Currently not used as GDI objects cannot be shared between DCs
+    // Text measurement cache (see MeasureText)
+    struct TextMeasure {
+        SIZE size;
+        std::list<std::wstring>::iterator lruIt;
+    };
+    static const size_t MEASURE_CACHE_CAPACITY = 1024;
+    std::unordered_map<std::wstring, TextMeasure> measureCache_;
+    std::list<std::wstring> measureLru_; // front = dùng gần nhất
+    static std::wstring MakeMeasureKey(HFONT font, int wrapWidth, UINT format,
+                                       const std::wstring& text);
+
+    // Descriptor-keyed cache cho GetFont/GetBrush/GetPen (handle sở hữu
+    // bởi cache, sống tới ClearCache/destructor). GDI object dùng được
+    // từ nhiều DC - chỉ việc SelectObject vào DC đang vẽ.
     std::unordered_map<std::string, GDIFontPtr> fontCache_;
     std::unordered_map<std::string, GDIBrushPtr> brushCache_;
     std::unordered_map<std::string, GDIPenPtr> penCache_;
-    
-    // Helper functions for generating cache keys (kept for future use)
-    std::string MakeFontKey(int height, int width, int weight, 
+
+    // Helper functions for generating cache keys
+    std::string MakeFontKey(int height, int width, int weight,
                            BOOL italic, const wchar_t* faceName);
     std::string MakeBrushKey(COLORREF color);
     std::string MakePenKey(int style, int width, COLORREF color);
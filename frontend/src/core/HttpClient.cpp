@@ -1,6 +1,8 @@
 #include "HttpClient.h"
 #include "JsonParser.h"
 #include "ErrorHandler.h"
+#include "PerfMetrics.h"
+#include "TaskScheduler.h"
 #include <windows.h>
 #include <wininet.h>
 #include <sstream>
@@ -8,13 +10,281 @@
 #include <fstream>
 #include <chrono>
 #include <ctime>
+#include <thread>
 #include <nlohmann/json.hpp>
 
 #pragma comment(lib, "wininet.lib")
 
-HttpClient::HttpClient(const std::string& baseUrl, const std::string& apiKey) 
+namespace {
+    // Percent-encode cho query parameters (RFC 3986 unreserved giữ nguyên)
+    std::string UrlEncode(const std::string& value) {
+        std::ostringstream encoded;
+        encoded << std::hex << std::uppercase << std::setfill('0');
+        for (unsigned char c : value) {
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~') {
+                encoded << c;
+            } else {
+                encoded << '%' << std::setw(2) << static_cast<int>(c);
+            }
+        }
+        return encoded.str();
+    }
+
+    // Post một chuỗi heap-allocated về window; tự dọn dẹp nếu window đã bị hủy
+    void PostStringMessage(HWND hwnd, UINT msg, UINT_PTR requestId, std::string text) {
+        TaskScheduler::PostResultToWindow(hwnd, msg, requestId, std::move(text));
+    }
+
+// SDK cũ có thể thiếu define này dù WinInet hỗ trợ từ lâu
+#ifndef INTERNET_OPTION_HTTP_DECODING
+#define INTERNET_OPTION_HTTP_DECODING 65
+#endif
+
+    // Quảng bá gzip/deflate và để WinInet tự giải nén body trước khi
+    // InternetReadFile trả về - caller vẫn nhận std::string plain text.
+    // Chỉ gửi Accept-Encoding khi bật decode thành công; nếu không thì
+    // server trả plain text và hành vi như cũ.
+    //
+    // KHÔNG dùng cho stream SSE (httpPostStreamInternal): giải nén theo
+    // block có thể giữ token trong bộ đệm nén thay vì nhả ra ngay.
+    void EnableCompressedTransfer(HINTERNET hRequest) {
+        BOOL decoding = TRUE;
+        if (InternetSetOptionA(hRequest, INTERNET_OPTION_HTTP_DECODING,
+                               &decoding, sizeof(decoding))) {
+            const char header[] = "Accept-Encoding: gzip, deflate\r\n";
+            HttpAddRequestHeadersA(hRequest, header, sizeof(header) - 1,
+                                   HTTP_ADDREQ_FLAG_ADD);
+        }
+    }
+}
+
+HttpClient::HttpClient(const std::string& baseUrl, const std::string& apiKey)
     : baseUrl_(baseUrl), apiKey_(apiKey) {}
 
+HttpClient::~HttpClient() {
+    // Đảm bảo worker threads còn chạy không post kết quả về window đã hủy
+    cancelPendingRequests();
+
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    if (hConnection_) {
+        InternetCloseHandle(hConnection_);
+        hConnection_ = NULL;
+    }
+    if (hSession_) {
+        InternetCloseHandle(hSession_);
+        hSession_ = NULL;
+    }
+}
+
+HINTERNET HttpClient::acquireConnection(const std::string& url, std::string& outPath,
+                                        std::string& outError, const char* context) {
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+
+    if (!hSession_) {
+        hSession_ = InternetOpenA("SenAI Client", INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
+        if (!hSession_) {
+            ErrorHandler::GetInstance().LogSystemError(
+                "Failed to initialize WinInet for " + url, context);
+            outError = "Error: Failed to initialize WinInet";
+            return NULL;
+        }
+    }
+
+    URL_COMPONENTSA urlComp;
+    ZeroMemory(&urlComp, sizeof(urlComp));
+    urlComp.dwStructSize = sizeof(urlComp);
+    urlComp.dwHostNameLength = -1;
+    urlComp.dwUrlPathLength = -1;
+
+    char hostName[256];
+    char urlPath[4096];
+    urlComp.lpszHostName = hostName;
+    urlComp.lpszUrlPath = urlPath;
+
+    if (!InternetCrackUrlA(url.c_str(), url.length(), 0, &urlComp)) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
+            "Failed to parse URL: " + url, context);
+        outError = "Error: Failed to parse URL";
+        return NULL;
+    }
+    outPath = urlPath;
+
+    // Host/port đổi (vd user sửa baseUrl trong Settings) -> bỏ connection cũ
+    if (hConnection_ && (connectedHost_ != hostName || connectedPort_ != urlComp.nPort)) {
+        InternetCloseHandle(hConnection_);
+        hConnection_ = NULL;
+    }
+
+    if (!hConnection_) {
+        hConnection_ = InternetConnectA(hSession_, hostName, urlComp.nPort, NULL, NULL,
+                                        INTERNET_SERVICE_HTTP, 0, 0);
+        if (!hConnection_) {
+            DWORD error = GetLastError();
+            ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
+                "Failed to connect for " + url + " (Error: " + std::to_string(error) + ")", context);
+            outError = "Error: Failed to connect";
+            return NULL;
+        }
+        connectedHost_ = hostName;
+        connectedPort_ = urlComp.nPort;
+    }
+
+    return hConnection_;
+}
+
+void HttpClient::invalidateConnection() {
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    if (hConnection_) {
+        InternetCloseHandle(hConnection_);
+        hConnection_ = NULL;
+    }
+}
+
+void HttpClient::cancelPendingRequests() {
+    asyncGeneration_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HttpClient::abortPendingRequests() {
+    cancelPendingRequests();
+    // Đóng handle cha làm mọi call đang block trên handle con trả về lỗi
+    // ngay lập tức (kỹ thuật cancel chuẩn của WinInet synchronous mode)
+    invalidateConnection();
+}
+
+void HttpClient::sendMessageAsync(const std::string& message, const std::string& sessionId,
+                                  HWND notifyWnd, UINT completionMsg, UINT_PTR requestId) {
+    unsigned int generation = asyncGeneration_.load(std::memory_order_relaxed);
+
+    // Worker của TaskScheduler chạy blocking sendMessage; UI thread tiếp tục
+    // xử lý messages. Cancel vẫn qua generation counter như trước.
+    TaskScheduler::GetInstance().Post(TaskPriority::UserBlocking,
+        [this, message, sessionId, notifyWnd, completionMsg, requestId, generation]() {
+            std::string response = sendMessage(message, sessionId);
+
+            // Bị cancel trong lúc request đang bay -> bỏ qua kết quả
+            if (asyncGeneration_.load(std::memory_order_relaxed) != generation) {
+                return;
+            }
+
+            TaskScheduler::PostResultToWindow(notifyWnd, completionMsg, requestId,
+                                              std::move(response));
+        });
+}
+
+void HttpClient::sendMessageStreamAsync(const std::string& message,
+                                        HWND notifyWnd, UINT deltaMsg, UINT doneMsg,
+                                        UINT_PTR requestId) {
+    unsigned int generation = asyncGeneration_.load(std::memory_order_relaxed);
+    // Backend nhận user_message qua query parameter (xem routes.py /api/llm/stream)
+    std::string url = baseUrl_ + "/api/llm/stream?user_message=" + UrlEncode(message);
+
+    // Chiếm một worker trong suốt thời gian stream - chấp nhận được vì
+    // mỗi lúc chỉ có một stream (xem doc TaskScheduler)
+    TaskScheduler::GetInstance().Post(TaskPriority::UserBlocking,
+        [this, url, notifyWnd, deltaMsg, doneMsg, requestId, generation]() {
+            httpPostStreamInternal(url, notifyWnd, deltaMsg, doneMsg, requestId, generation);
+        });
+}
+
+void HttpClient::httpPostStreamInternal(const std::string& url, HWND notifyWnd,
+                                        UINT deltaMsg, UINT doneMsg, UINT_PTR requestId,
+                                        unsigned int generation) {
+    std::string urlPath, connectError;
+    HINTERNET hConnect = acquireConnection(url, urlPath, connectError, "HttpClient::httpPostStreamInternal");
+    if (!hConnect) {
+        PostStringMessage(notifyWnd, doneMsg, requestId, connectError);
+        return;
+    }
+
+    HINTERNET hRequest = HttpOpenRequestA(hConnect, "POST", urlPath.c_str(), NULL, NULL, NULL,
+                                          INTERNET_FLAG_RELOAD | INTERNET_FLAG_KEEP_CONNECTION, 0);
+    if (!hRequest) {
+        PostStringMessage(notifyWnd, doneMsg, requestId, "Error: Failed to open request");
+        return;
+    }
+
+    std::string headers = buildHeaders();
+    headers += "Accept: text/event-stream\r\n";
+    HttpAddRequestHeadersA(hRequest, headers.c_str(), headers.length(), HTTP_ADDREQ_FLAG_ADD);
+
+    // Receive timeout dài hơn bình thường: giữa các token có thể có khoảng lặng
+    DWORD timeout = 120000;
+    InternetSetOptionA(hRequest, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout, sizeof(timeout));
+
+    if (!HttpSendRequestA(hRequest, NULL, 0, NULL, 0)) {
+        InternetCloseHandle(hRequest);
+        invalidateConnection();
+        PostStringMessage(notifyWnd, doneMsg, requestId, "Error: Failed to send request");
+        return;
+    }
+
+    DWORD statusCode = 0;
+    DWORD statusCodeSize = sizeof(statusCode);
+    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
+                      &statusCode, &statusCodeSize, NULL) && statusCode >= 400) {
+        InternetCloseHandle(hRequest);
+        PostStringMessage(notifyWnd, doneMsg, requestId, "Error: HTTP " + std::to_string(statusCode));
+        return;
+    }
+
+    // Đọc theo chunk và tách từng SSE event ("data: {...}\n\n").
+    // Chunk có thể cắt giữa event nên phải giữ phần dư trong carry buffer.
+    std::string carry;
+    std::string errorText;
+    char buffer[4096];
+    DWORD bytesRead;
+    bool done = false;
+
+    while (!done && InternetReadFile(hRequest, buffer, sizeof(buffer), &bytesRead) && bytesRead > 0) {
+        // Bị cancel (session mới) -> dừng đọc, không post gì thêm
+        if (asyncGeneration_.load(std::memory_order_relaxed) != generation) {
+            InternetCloseHandle(hRequest);
+            return;
+        }
+
+        carry.append(buffer, bytesRead);
+
+        size_t eventEnd;
+        while ((eventEnd = carry.find("\n\n")) != std::string::npos) {
+            std::string eventLine = carry.substr(0, eventEnd);
+            carry.erase(0, eventEnd + 2);
+
+            const std::string dataPrefix = "data: ";
+            size_t dataPos = eventLine.find(dataPrefix);
+            if (dataPos == std::string::npos) {
+                continue; // comment/heartbeat line
+            }
+            std::string dataJson = eventLine.substr(dataPos + dataPrefix.length());
+
+            // Một event chỉ parse một lần (mỗi token một event nên chỗ này nóng)
+            JsonParser::ParsedDocument event(dataJson);
+
+            std::string errorField = event.GetString("error");
+            if (!errorField.empty()) {
+                errorText = errorField;
+                done = true;
+                break;
+            }
+            if (event.GetBool("done")) {
+                done = true;
+                break;
+            }
+            std::string content = event.GetString("content");
+            if (!content.empty()) {
+                PostStringMessage(notifyWnd, deltaMsg, requestId, std::move(content));
+            }
+        }
+    }
+
+    InternetCloseHandle(hRequest);
+
+    if (asyncGeneration_.load(std::memory_order_relaxed) != generation) {
+        return;
+    }
+    PostStringMessage(notifyWnd, doneMsg, requestId, errorText);
+}
+
 
 std::string HttpClient::buildHeaders() {
     std::ostringstream headers;
@@ -40,47 +310,19 @@ std::string HttpClient::httpGet(const std::string& endpoint) {
 }
 
 std::string HttpClient::httpGetInternal(const std::string& url) {
+    PerfMetrics::ScopedTimer timer("http.get");
     std::string result;
-    
-    HINTERNET hInternet = InternetOpenA("SenAI Client", INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
-    if (!hInternet) {
-        ErrorHandler::GetInstance().LogSystemError(
-            "Failed to initialize WinInet for GET " + url, "HttpClient::httpGetInternal");
-        return "Error: Failed to initialize WinInet";
-    }
-    
-    URL_COMPONENTSA urlComp;
-    ZeroMemory(&urlComp, sizeof(urlComp));
-    urlComp.dwStructSize = sizeof(urlComp);
-    urlComp.dwHostNameLength = -1;
-    urlComp.dwUrlPathLength = -1;
-    
-    char hostName[256];
-    char urlPath[1024];
-    urlComp.lpszHostName = hostName;
-    urlComp.lpszUrlPath = urlPath;
-    
-    if (!InternetCrackUrlA(url.c_str(), url.length(), 0, &urlComp)) {
-        InternetCloseHandle(hInternet);
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to parse URL for GET: " + url, "HttpClient::httpGetInternal");
-        return "Error: Failed to parse URL";
-    }
-    
-    HINTERNET hConnect = InternetConnectA(hInternet, hostName, urlComp.nPort, NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+
+    // Dùng session/connection dùng chung (keep-alive) thay vì mở mới mỗi request
+    std::string urlPath, connectError;
+    HINTERNET hConnect = acquireConnection(url, urlPath, connectError, "HttpClient::httpGetInternal");
     if (!hConnect) {
-        InternetCloseHandle(hInternet);
-        DWORD error = GetLastError();
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to connect for GET " + url + " (Error: " + std::to_string(error) + ")", 
-            "HttpClient::httpGetInternal");
-        return "Error: Failed to connect";
+        return connectError;
     }
-    
-    HINTERNET hRequest = HttpOpenRequestA(hConnect, "GET", urlPath, NULL, NULL, NULL, INTERNET_FLAG_RELOAD, 0);
+
+    HINTERNET hRequest = HttpOpenRequestA(hConnect, "GET", urlPath.c_str(), NULL, NULL, NULL,
+                                          INTERNET_FLAG_RELOAD | INTERNET_FLAG_KEEP_CONNECTION, 0);
     if (!hRequest) {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
         ErrorHandler::GetInstance().LogSystemError(
             "Failed to open GET request for " + url, "HttpClient::httpGetInternal");
         return "Error: Failed to open request";
@@ -96,13 +338,21 @@ std::string HttpClient::httpGetInternal(const std::string& url) {
     DWORD timeout = 30000;
     InternetSetOptionA(hRequest, INTERNET_OPTION_SEND_TIMEOUT, &timeout, sizeof(timeout));
     InternetSetOptionA(hRequest, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout, sizeof(timeout));
-    
-    if (!HttpSendRequestA(hRequest, NULL, 0, NULL, 0)) {
+
+    // Body /conversations nén gzip nhỏ hơn nhiều lần (toàn JSON text)
+    EnableCompressedTransfer(hRequest);
+
+    // Breakdown cho HUD: send (gồm cả chờ backend nhận) vs read body
+    bool sendOk;
+    {
+        PerfMetrics::ScopedTimer sendTimer("http.get.send");
+        sendOk = HttpSendRequestA(hRequest, NULL, 0, NULL, 0) != FALSE;
+    }
+    if (!sendOk) {
         DWORD error = GetLastError();
         InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        
+        invalidateConnection(); // Socket keep-alive có thể đã chết; retry sẽ connect lại
+
         std::string errorMsg = "Failed to send GET request for " + url;
         if (error == ERROR_INTERNET_TIMEOUT) {
             errorMsg += " (Timeout)";
@@ -111,34 +361,33 @@ std::string HttpClient::httpGetInternal(const std::string& url) {
             errorMsg + " (Error: " + std::to_string(error) + ")", "HttpClient::httpGetInternal");
         return "Error: Failed to send request";
     }
-    
+
     // Check HTTP status code
     DWORD statusCode = 0;
     DWORD statusCodeSize = sizeof(statusCode);
-    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, 
+    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
                       &statusCode, &statusCodeSize, NULL)) {
         if (statusCode >= 400) {
             InternetCloseHandle(hRequest);
-            InternetCloseHandle(hConnect);
-            InternetCloseHandle(hInternet);
             ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-                "HTTP error " + std::to_string(statusCode) + " for GET " + url, 
+                "HTTP error " + std::to_string(statusCode) + " for GET " + url,
                 "HttpClient::httpGetInternal");
             return "Error: HTTP " + std::to_string(statusCode);
         }
     }
-    
-    char buffer[4096];
-    DWORD bytesRead;
-    while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0) {
-        buffer[bytesRead] = '\0';
-        result += buffer;
+
+    {
+        PerfMetrics::ScopedTimer readTimer("http.get.read");
+        char buffer[4096];
+        DWORD bytesRead;
+        while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0) {
+            buffer[bytesRead] = '\0';
+            result += buffer;
+        }
     }
-    
+
     InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
-    
+
     return result;
 }
 
@@ -157,47 +406,18 @@ std::string HttpClient::httpPost(const std::string& endpoint, const std::string&
 }
 
 std::string HttpClient::httpPostInternal(const std::string& url, const std::string& jsonData) {
+    PerfMetrics::ScopedTimer timer("http.post");
     std::string result;
-    
-    HINTERNET hInternet = InternetOpenA("SenAI Client", INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
-    if (!hInternet) {
-        ErrorHandler::GetInstance().LogSystemError(
-            "Failed to initialize WinInet for POST " + url, "HttpClient::httpPostInternal");
-        return "Error: Failed to initialize WinInet";
-    }
-    
-    URL_COMPONENTSA urlComp;
-    ZeroMemory(&urlComp, sizeof(urlComp));
-    urlComp.dwStructSize = sizeof(urlComp);
-    urlComp.dwHostNameLength = -1;
-    urlComp.dwUrlPathLength = -1;
-    
-    char hostName[256];
-    char urlPath[1024];
-    urlComp.lpszHostName = hostName;
-    urlComp.lpszUrlPath = urlPath;
-    
-    if (!InternetCrackUrlA(url.c_str(), url.length(), 0, &urlComp)) {
-        InternetCloseHandle(hInternet);
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to parse URL for POST: " + url, "HttpClient::httpPostInternal");
-        return "Error: Failed to parse URL";
-    }
-    
-    HINTERNET hConnect = InternetConnectA(hInternet, hostName, urlComp.nPort, NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+
+    std::string urlPath, connectError;
+    HINTERNET hConnect = acquireConnection(url, urlPath, connectError, "HttpClient::httpPostInternal");
     if (!hConnect) {
-        InternetCloseHandle(hInternet);
-        DWORD error = GetLastError();
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to connect for POST " + url + " (Error: " + std::to_string(error) + ")", 
-            "HttpClient::httpPostInternal");
-        return "Error: Failed to connect";
+        return connectError;
     }
-    
-    HINTERNET hRequest = HttpOpenRequestA(hConnect, "POST", urlPath, NULL, NULL, NULL, INTERNET_FLAG_RELOAD, 0);
+
+    HINTERNET hRequest = HttpOpenRequestA(hConnect, "POST", urlPath.c_str(), NULL, NULL, NULL,
+                                          INTERNET_FLAG_RELOAD | INTERNET_FLAG_KEEP_CONNECTION, 0);
     if (!hRequest) {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
         ErrorHandler::GetInstance().LogSystemError(
             "Failed to open POST request for " + url, "HttpClient::httpPostInternal");
         return "Error: Failed to open request";
@@ -210,13 +430,21 @@ std::string HttpClient::httpPostInternal(const std::string& url, const std::stri
     DWORD timeout = 60000;
     InternetSetOptionA(hRequest, INTERNET_OPTION_SEND_TIMEOUT, &timeout, sizeof(timeout));
     InternetSetOptionA(hRequest, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout, sizeof(timeout));
-    
-    if (!HttpSendRequestA(hRequest, NULL, 0, (LPVOID)jsonData.c_str(), jsonData.length())) {
+
+    EnableCompressedTransfer(hRequest);
+
+    // Breakdown cho HUD: send (upload + chờ backend xử lý) vs read body
+    bool sendOk;
+    {
+        PerfMetrics::ScopedTimer sendTimer("http.post.send");
+        sendOk = HttpSendRequestA(hRequest, NULL, 0,
+                                  (LPVOID)jsonData.c_str(), jsonData.length()) != FALSE;
+    }
+    if (!sendOk) {
         DWORD error = GetLastError();
         InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        
+        invalidateConnection();
+
         std::string errorMsg = "Failed to send POST request for " + url;
         if (error == ERROR_INTERNET_TIMEOUT) {
             errorMsg += " (Timeout)";
@@ -225,34 +453,33 @@ std::string HttpClient::httpPostInternal(const std::string& url, const std::stri
             errorMsg + " (Error: " + std::to_string(error) + ")", "HttpClient::httpPostInternal");
         return "Error: Failed to send request";
     }
-    
+
     // Check HTTP status code
     DWORD statusCode = 0;
     DWORD statusCodeSize = sizeof(statusCode);
-    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, 
+    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
                       &statusCode, &statusCodeSize, NULL)) {
         if (statusCode >= 400) {
             InternetCloseHandle(hRequest);
-            InternetCloseHandle(hConnect);
-            InternetCloseHandle(hInternet);
             ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-                "HTTP error " + std::to_string(statusCode) + " for POST " + url, 
+                "HTTP error " + std::to_string(statusCode) + " for POST " + url,
                 "HttpClient::httpPostInternal");
             return "Error: HTTP " + std::to_string(statusCode);
         }
     }
-    
-    char buffer[4096];
-    DWORD bytesRead;
-    while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0) {
-        buffer[bytesRead] = '\0';
-        result += buffer;
+
+    {
+        PerfMetrics::ScopedTimer readTimer("http.post.read");
+        char buffer[4096];
+        DWORD bytesRead;
+        while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0) {
+            buffer[bytesRead] = '\0';
+            result += buffer;
+        }
     }
-    
+
     InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
-    
+
     return result;
 }
 
@@ -272,46 +499,16 @@ std::string HttpClient::httpPut(const std::string& endpoint, const std::string&
 
 std::string HttpClient::httpPutInternal(const std::string& url, const std::string& jsonData) {
     std::string result;
-    
-    HINTERNET hInternet = InternetOpenA("SenAI Client", INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, 0);
-    if (!hInternet) {
-        ErrorHandler::GetInstance().LogSystemError(
-            "Failed to initialize WinInet for PUT " + url, "HttpClient::httpPutInternal");
-        return "Error: Failed to initialize WinInet";
-    }
-    
-    URL_COMPONENTSA urlComp;
-    ZeroMemory(&urlComp, sizeof(urlComp));
-    urlComp.dwStructSize = sizeof(urlComp);
-    urlComp.dwHostNameLength = -1;
-    urlComp.dwUrlPathLength = -1;
-    
-    char hostName[256];
-    char urlPath[1024];
-    urlComp.lpszHostName = hostName;
-    urlComp.lpszUrlPath = urlPath;
-    
-    if (!InternetCrackUrlA(url.c_str(), url.length(), 0, &urlComp)) {
-        InternetCloseHandle(hInternet);
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to parse URL for PUT: " + url, "HttpClient::httpPutInternal");
-        return "Error: Failed to parse URL";
-    }
-    
-    HINTERNET hConnect = InternetConnectA(hInternet, hostName, urlComp.nPort, NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+
+    std::string urlPath, connectError;
+    HINTERNET hConnect = acquireConnection(url, urlPath, connectError, "HttpClient::httpPutInternal");
     if (!hConnect) {
-        InternetCloseHandle(hInternet);
-        DWORD error = GetLastError();
-        ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-            "Failed to connect for PUT " + url + " (Error: " + std::to_string(error) + ")", 
-            "HttpClient::httpPutInternal");
-        return "Error: Failed to connect";
+        return connectError;
     }
-    
-    HINTERNET hRequest = HttpOpenRequestA(hConnect, "PUT", urlPath, NULL, NULL, NULL, INTERNET_FLAG_RELOAD, 0);
+
+    HINTERNET hRequest = HttpOpenRequestA(hConnect, "PUT", urlPath.c_str(), NULL, NULL, NULL,
+                                          INTERNET_FLAG_RELOAD | INTERNET_FLAG_KEEP_CONNECTION, 0);
     if (!hRequest) {
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
         ErrorHandler::GetInstance().LogSystemError(
             "Failed to open PUT request for " + url, "HttpClient::httpPutInternal");
         return "Error: Failed to open request";
@@ -324,13 +521,14 @@ std::string HttpClient::httpPutInternal(const std::string& url, const std::strin
     DWORD timeout = 30000;
     InternetSetOptionA(hRequest, INTERNET_OPTION_SEND_TIMEOUT, &timeout, sizeof(timeout));
     InternetSetOptionA(hRequest, INTERNET_OPTION_RECEIVE_TIMEOUT, &timeout, sizeof(timeout));
-    
+
+    EnableCompressedTransfer(hRequest);
+
     if (!HttpSendRequestA(hRequest, NULL, 0, (LPVOID)jsonData.c_str(), jsonData.length())) {
         DWORD error = GetLastError();
         InternetCloseHandle(hRequest);
-        InternetCloseHandle(hConnect);
-        InternetCloseHandle(hInternet);
-        
+        invalidateConnection();
+
         std::string errorMsg = "Failed to send PUT request for " + url;
         if (error == ERROR_INTERNET_TIMEOUT) {
             errorMsg += " (Timeout)";
@@ -339,34 +537,30 @@ std::string HttpClient::httpPutInternal(const std::string& url, const std::strin
             errorMsg + " (Error: " + std::to_string(error) + ")", "HttpClient::httpPutInternal");
         return "Error: Failed to send request";
     }
-    
+
     // Check HTTP status code
     DWORD statusCode = 0;
     DWORD statusCodeSize = sizeof(statusCode);
-    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, 
+    if (HttpQueryInfoA(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
                       &statusCode, &statusCodeSize, NULL)) {
         if (statusCode >= 400) {
             InternetCloseHandle(hRequest);
-            InternetCloseHandle(hConnect);
-            InternetCloseHandle(hInternet);
             ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
-                "HTTP error " + std::to_string(statusCode) + " for PUT " + url, 
+                "HTTP error " + std::to_string(statusCode) + " for PUT " + url,
                 "HttpClient::httpPutInternal");
             return "Error: HTTP " + std::to_string(statusCode);
         }
     }
-    
+
     char buffer[4096];
     DWORD bytesRead;
     while (InternetReadFile(hRequest, buffer, sizeof(buffer) - 1, &bytesRead) && bytesRead > 0) {
         buffer[bytesRead] = '\0';
         result += buffer;
     }
-    
+
     InternetCloseHandle(hRequest);
-    InternetCloseHandle(hConnect);
-    InternetCloseHandle(hInternet);
-    
+
     return result;
 }
 
@@ -374,6 +568,66 @@ std::string HttpClient::checkHealth() {
     return httpGet("/health");
 }
 
+void HttpClient::checkHealthAsync(HWND notifyWnd, UINT completionMsg, UINT_PTR requestId) {
+    unsigned int generation = asyncGeneration_.load(std::memory_order_relaxed);
+
+    // Polling nền -> lane Prefetch, không chen trước send/refresh của user
+    TaskScheduler::GetInstance().Post(TaskPriority::Prefetch,
+        [this, notifyWnd, completionMsg, requestId, generation]() {
+            std::string response = checkHealth();
+
+            if (asyncGeneration_.load(std::memory_order_relaxed) != generation) {
+                return;
+            }
+
+            TaskScheduler::PostResultToWindow(notifyWnd, completionMsg, requestId,
+                                              std::move(response));
+        });
+}
+
+
+void HttpClient::getConversationsAsync(const std::string& sessionId, int skip, int limit,
+                                       HWND notifyWnd, UINT completionMsg, UINT_PTR requestId) {
+    // KHÔNG đi qua asyncGeneration_: cancelPendingRequests (click sidebar,
+    // session mới) nhắm vào send/stream chứ không phải lượt refresh sidebar
+    // đang chạy. Nuốt mất một page result ở đây làm state machine refresh
+    // kẹt vĩnh viễn ở conversationsFetchActive_; staleness đã do caller lo
+    // bằng requestId (conversationsRequestId_ ở OnConversationsPageResult).
+    TaskScheduler::GetInstance().Post(TaskPriority::UserBlocking,
+        [this, sessionId, skip, limit, notifyWnd, completionMsg, requestId]() {
+            std::string response = getConversations(sessionId, skip, limit);
+
+            TaskScheduler::PostResultToWindow(notifyWnd, completionMsg, requestId,
+                                              std::move(response));
+        });
+}
+
+void HttpClient::prefetchConversationsAsync(const std::string& sessionId,
+                                            HWND notifyWnd, UINT completionMsg, UINT_PTR requestId) {
+    unsigned int generation = asyncGeneration_.load(std::memory_order_relaxed);
+
+    // Speculative (user mới hover, chưa click) -> lane Prefetch,
+    // nhường worker cho mọi request user thực sự đang chờ
+    TaskScheduler::GetInstance().Post(TaskPriority::Prefetch,
+        [this, sessionId, notifyWnd, completionMsg, requestId, generation]() {
+            std::string response = getConversations(sessionId);
+
+            if (asyncGeneration_.load(std::memory_order_relaxed) != generation) {
+                return;
+            }
+
+            TaskScheduler::PostResultToWindow(notifyWnd, completionMsg, requestId,
+                                              std::move(response));
+        });
+}
+
+std::string HttpClient::pollConversationUpdates(int afterId, int timeoutSec) {
+    // Không qua httpGet: retry 3 lần + log mỗi lần fail sẽ spam khi backend
+    // chết, trong khi vòng poll của UpdateChannel đã tự backoff và thử lại
+    std::string url = baseUrl_ + "/conversations/updates?after_id=" +
+                      std::to_string(afterId) + "&timeout=" + std::to_string(timeoutSec);
+    return httpGetInternal(url);
+}
 
 std::string HttpClient::sendMessage(const std::string& message, const std::string& sessionId) {
     try {
@@ -394,14 +648,16 @@ std::string HttpClient::sendMessage(const std::string& message, const std::strin
             return response; // Return error message as-is
         }
         
-        // Extract ai_response từ JSON response using JsonParser
-        std::string aiResponse = JsonParser::GetString(response, "ai_response");
+        // Parse response một lần rồi extract các field (ParsedDocument)
+        JsonParser::ParsedDocument doc(response);
+
+        std::string aiResponse = doc.GetString("ai_response");
         if (!aiResponse.empty()) {
             return aiResponse;
         }
-        
+
         // Nếu không tìm thấy ai_response, kiểm tra xem có phải là error response không
-        std::string errorDetail = JsonParser::GetString(response, "detail");
+        std::string errorDetail = doc.GetString("detail");
         if (!errorDetail.empty()) {
             ErrorHandler::GetInstance().LogError(ErrorCategory::Network, ErrorSeverity::Error,
                 "Backend returned error detail: " + errorDetail, "HttpClient::sendMessage");
@@ -418,10 +674,19 @@ std::string HttpClient::sendMessage(const std::string& message, const std::strin
     }
 }
 
-std::string HttpClient::getConversations(const std::string& sessionId) {
+std::string HttpClient::getConversations(const std::string& sessionId, int skip, int limit) {
     std::string endpoint = "/conversations";
+    std::string sep = "?";
     if (!sessionId.empty()) {
-        endpoint += "?session_id=" + sessionId;
+        endpoint += sep + "session_id=" + sessionId;
+        sep = "&";
+    }
+    if (skip > 0) {
+        endpoint += sep + "skip=" + std::to_string(skip);
+        sep = "&";
+    }
+    if (limit > 0) {
+        endpoint += sep + "limit=" + std::to_string(limit);
     }
     return httpGet(endpoint);
 }
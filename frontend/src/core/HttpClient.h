@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <windows.h>
 
 // Kết quả chuẩn hóa (hiện tại mới dùng cho logging, tương lai có thể dùng rộng hơn)
 struct HttpResult {
@@ -11,13 +14,87 @@ struct HttpResult {
 class HttpClient {
 public:
     HttpClient(const std::string& baseUrl = "http://localhost:8000", const std::string& apiKey = "");
-    
+    ~HttpClient();
+
     // Health check
     std::string checkHealth();
-    
+
+    /**
+     * Health check trên worker thread: backend chết thì WinInet timeout
+     * xảy ra ở worker chứ không treo UI thread. Kết quả post về notifyWnd
+     * qua PostMessageW(notifyWnd, completionMsg, requestId,
+     * (LPARAM) new std::string(response)) — receiver chịu trách nhiệm delete.
+     */
+    void checkHealthAsync(HWND notifyWnd, UINT completionMsg, UINT_PTR requestId);
+
     // Conversation endpoints
     std::string sendMessage(const std::string& message, const std::string& sessionId = "");
-    std::string getConversations(const std::string& sessionId = "");
+    // skip/limit map thẳng vào query params của GET /conversations (backend trả
+    // newest-first). limit = 0 nghĩa là không gửi param, dùng default của backend.
+    std::string getConversations(const std::string& sessionId = "", int skip = 0, int limit = 0);
+
+    /**
+     * Một page GET /conversations trên worker thread - startup fetch chạy
+     * song song với health check thay vì xếp hàng sau nó. Kết quả post về
+     * notifyWnd qua PostMessageW(notifyWnd, completionMsg, requestId,
+     * (LPARAM) new std::string(response)) — receiver chịu trách nhiệm delete.
+     *
+     * Không bị cancelPendingRequests() nuốt kết quả: lượt refresh sidebar
+     * chạy nhiều page nối nhau và phải luôn nhận được kết quả (kể cả lỗi)
+     * để đóng lượt; bỏ request cũ là việc của caller qua requestId.
+     */
+    void getConversationsAsync(const std::string& sessionId, int skip, int limit,
+                               HWND notifyWnd, UINT completionMsg, UINT_PTR requestId);
+
+    /**
+     * Prefetch transcript của một session khi user hover sidebar. Như
+     * getConversationsAsync nhưng đi lane Prefetch: user mới chỉ hover,
+     * không được tranh worker với việc user thực sự đang chờ.
+     */
+    void prefetchConversationsAsync(const std::string& sessionId,
+                                    HWND notifyWnd, UINT completionMsg, UINT_PTR requestId);
+
+    /**
+     * Long-poll GET /conversations/updates: block tới khi backend có
+     * conversation mới hơn afterId hoặc hết timeoutSec (server trả
+     * {"changed": false}). BLOCKING trong suốt timeout - chỉ gọi từ thread
+     * riêng (xem UpdateChannel), không bao giờ từ UI thread hay worker pool.
+     * Không retry: vòng poll của caller tự là cơ chế thử lại.
+     */
+    std::string pollConversationUpdates(int afterId, int timeoutSec);
+
+    /**
+     * Gửi message trên worker thread để không block UI thread.
+     * Kết quả được post về notifyWnd qua PostMessageW(notifyWnd, completionMsg,
+     * requestId, (LPARAM) new std::string(response)) — receiver chịu trách nhiệm delete.
+     * Nếu cancelPendingRequests() được gọi trước khi request hoàn tất thì không post gì cả.
+     */
+    void sendMessageAsync(const std::string& message, const std::string& sessionId,
+                          HWND notifyWnd, UINT completionMsg, UINT_PTR requestId);
+
+    // Hủy mọi async request đang bay (ví dụ khi user bắt đầu session mới giữa chừng).
+    // Worker thread vẫn chạy đến khi WinInet trả về, nhưng kết quả sẽ bị bỏ qua.
+    void cancelPendingRequests();
+
+    // Hủy cứng: ngoài bỏ qua kết quả còn đóng connection dùng chung, làm các
+    // call blocking trên handle con fail ngay (ERROR_INTERNET_OPERATION_CANCELLED)
+    // thay vì chờ hết timeout. Dùng lúc shutdown để join thread nền
+    // (long-poll/stream) không phải đợi request đang bay tự kết thúc.
+    void abortPendingRequests();
+
+    /**
+     * Streaming mode: đọc response SSE từ POST /api/llm/stream theo từng chunk
+     * và post mỗi text delta về UI thread ngay khi nhận được, thay vì buffer
+     * toàn bộ response. First-token latency nhờ vậy chỉ còn bằng thời gian
+     * backend sinh token đầu tiên.
+     *
+     * Mỗi delta: PostMessageW(notifyWnd, deltaMsg, requestId, (LPARAM) new std::string(deltaUtf8)).
+     * Khi kết thúc (done hoặc lỗi): PostMessageW(notifyWnd, doneMsg, requestId,
+     * (LPARAM) new std::string(errorOrEmpty)). Receiver sở hữu và delete các chuỗi này.
+     */
+    void sendMessageStreamAsync(const std::string& message,
+                                HWND notifyWnd, UINT deltaMsg, UINT doneMsg,
+                                UINT_PTR requestId);
     
     // Task endpoints
     std::string createTask(const std::string& taskName, const std::string& description = "");
@@ -33,6 +110,33 @@ public:
 private:
     std::string baseUrl_;
     std::string apiKey_;
+    // Generation counter cho async requests: mỗi lần cancel thì tăng lên,
+    // worker chỉ post kết quả khi generation lúc bắt đầu vẫn còn hiện hành.
+    std::atomic<unsigned int> asyncGeneration_{0};
+
+    // Session và connection WinInet sống theo vòng đời HttpClient.
+    // Trước đây mỗi request mở/đóng InternetOpenA + InternetConnectA riêng,
+    // nghĩa là health check 10s/lần và sidebar refresh đều trả giá TCP handshake mới.
+    // Giữ handle lâu dài + INTERNET_FLAG_KEEP_CONNECTION cho phép WinInet
+    // tái sử dụng socket giữa các request tới cùng host.
+    HINTERNET hSession_ = NULL;
+    HINTERNET hConnection_ = NULL;
+    std::string connectedHost_; // Host/port mà hConnection_ đang trỏ tới
+    WORD connectedPort_ = 0;
+    std::mutex connectionMutex_; // Bảo vệ các field trên (worker threads dùng chung client)
+
+    /**
+     * Trả về connection handle dùng chung cho url (tạo session/connection lazy,
+     * reconnect khi host/port đổi — vd user đổi baseUrl trong Settings).
+     * outPath nhận phần path+query của url; khi thất bại trả về NULL và
+     * outError chứa chuỗi "Error: ..." để caller trả thẳng về UI.
+     * Caller KHÔNG được đóng handle này.
+     */
+    HINTERNET acquireConnection(const std::string& url, std::string& outPath,
+                                std::string& outError, const char* context);
+    // Đóng connection đang cache (gọi khi send thất bại — socket keep-alive có thể đã chết,
+    // lần retry kế tiếp sẽ connect lại)
+    void invalidateConnection();
     std::string httpGet(const std::string& endpoint);
     std::string httpGetInternal(const std::string& url);
     std::string httpPost(const std::string& endpoint, const std::string& jsonData);
@@ -40,4 +144,7 @@ private:
     std::string httpPut(const std::string& endpoint, const std::string& jsonData);
     std::string httpPutInternal(const std::string& url, const std::string& jsonData);
     std::string buildHeaders();
+    void httpPostStreamInternal(const std::string& url, HWND notifyWnd,
+                                UINT deltaMsg, UINT doneMsg, UINT_PTR requestId,
+                                unsigned int generation);
 };
\ No newline at end of file
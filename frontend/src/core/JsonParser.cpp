@@ -37,17 +37,16 @@ std::unique_ptr<nlohmann::json> JsonParser::Parse(const std::string& jsonString)
     }
 }
 
-std::string JsonParser::GetString(const std::string& jsonString, 
-                                   const std::string& fieldName, 
-                                   const std::string& defaultValue) {
-    auto json = Parse(jsonString);
-    if (!json || !json->is_object()) {
+std::string JsonParser::GetStringFrom(const nlohmann::json& json,
+                                      const std::string& fieldName,
+                                      const std::string& defaultValue) {
+    if (!json.is_object()) {
         return defaultValue;
     }
 
     try {
-        if (json->contains(fieldName)) {
-            auto& value = (*json)[fieldName];
+        if (json.contains(fieldName)) {
+            const auto& value = json[fieldName];
             if (value.is_string()) {
                 return value.get<std::string>();
             } else if (value.is_null()) {
@@ -65,17 +64,16 @@ std::string JsonParser::GetString(const std::string& jsonString,
     return defaultValue;
 }
 
-int JsonParser::GetInt(const std::string& jsonString, 
-                       const std::string& fieldName, 
-                       int defaultValue) {
-    auto json = Parse(jsonString);
-    if (!json || !json->is_object()) {
+int JsonParser::GetIntFrom(const nlohmann::json& json,
+                           const std::string& fieldName,
+                           int defaultValue) {
+    if (!json.is_object()) {
         return defaultValue;
     }
 
     try {
-        if (json->contains(fieldName)) {
-            auto& value = (*json)[fieldName];
+        if (json.contains(fieldName)) {
+            const auto& value = json[fieldName];
             if (value.is_number_integer()) {
                 return value.get<int>();
             } else if (value.is_number_unsigned()) {
@@ -97,17 +95,16 @@ int JsonParser::GetInt(const std::string& jsonString,
     return defaultValue;
 }
 
-bool JsonParser::GetBool(const std::string& jsonString, 
-                         const std::string& fieldName, 
-                         bool defaultValue) {
-    auto json = Parse(jsonString);
-    if (!json || !json->is_object()) {
+bool JsonParser::GetBoolFrom(const nlohmann::json& json,
+                             const std::string& fieldName,
+                             bool defaultValue) {
+    if (!json.is_object()) {
         return defaultValue;
     }
 
     try {
-        if (json->contains(fieldName)) {
-            auto& value = (*json)[fieldName];
+        if (json.contains(fieldName)) {
+            const auto& value = json[fieldName];
             if (value.is_boolean()) {
                 return value.get<bool>();
             } else if (value.is_string()) {
@@ -125,23 +122,14 @@ bool JsonParser::GetBool(const std::string& jsonString,
     return defaultValue;
 }
 
-bool JsonParser::IsValid(const std::string& jsonString) {
-    return Parse(jsonString) != nullptr;
-}
-
-std::string JsonParser::GetNestedString(const std::string& jsonString,
-                                         const std::string& fieldPath,
-                                         const std::string& defaultValue) {
-    auto json = Parse(jsonString);
-    if (!json) {
-        return defaultValue;
-    }
-
+std::string JsonParser::GetNestedStringFrom(const nlohmann::json& json,
+                                            const std::string& fieldPath,
+                                            const std::string& defaultValue) {
     try {
         // Split path by dots
         std::istringstream pathStream(fieldPath);
         std::string segment;
-        nlohmann::json* current = json.get();
+        const nlohmann::json* current = &json;
 
         while (std::getline(pathStream, segment, '.')) {
             if (current->is_object() && current->contains(segment)) {
@@ -166,6 +154,59 @@ std::string JsonParser::GetNestedString(const std::string& jsonString,
     return defaultValue;
 }
 
+JsonParser::ParsedDocument::ParsedDocument(const std::string& jsonString)
+    : json_(Parse(jsonString)) {}
+
+std::string JsonParser::ParsedDocument::GetString(const std::string& fieldName,
+                                                  const std::string& defaultValue) const {
+    return json_ ? GetStringFrom(*json_, fieldName, defaultValue) : defaultValue;
+}
+
+int JsonParser::ParsedDocument::GetInt(const std::string& fieldName, int defaultValue) const {
+    return json_ ? GetIntFrom(*json_, fieldName, defaultValue) : defaultValue;
+}
+
+bool JsonParser::ParsedDocument::GetBool(const std::string& fieldName, bool defaultValue) const {
+    return json_ ? GetBoolFrom(*json_, fieldName, defaultValue) : defaultValue;
+}
+
+std::string JsonParser::ParsedDocument::GetNestedString(const std::string& fieldPath,
+                                                        const std::string& defaultValue) const {
+    return json_ ? GetNestedStringFrom(*json_, fieldPath, defaultValue) : defaultValue;
+}
+
+std::string JsonParser::GetString(const std::string& jsonString,
+                                   const std::string& fieldName,
+                                   const std::string& defaultValue) {
+    auto json = Parse(jsonString);
+    return json ? GetStringFrom(*json, fieldName, defaultValue) : defaultValue;
+}
+
+int JsonParser::GetInt(const std::string& jsonString,
+                       const std::string& fieldName,
+                       int defaultValue) {
+    auto json = Parse(jsonString);
+    return json ? GetIntFrom(*json, fieldName, defaultValue) : defaultValue;
+}
+
+bool JsonParser::GetBool(const std::string& jsonString,
+                         const std::string& fieldName,
+                         bool defaultValue) {
+    auto json = Parse(jsonString);
+    return json ? GetBoolFrom(*json, fieldName, defaultValue) : defaultValue;
+}
+
+bool JsonParser::IsValid(const std::string& jsonString) {
+    return Parse(jsonString) != nullptr;
+}
+
+std::string JsonParser::GetNestedString(const std::string& jsonString,
+                                         const std::string& fieldPath,
+                                         const std::string& defaultValue) {
+    auto json = Parse(jsonString);
+    return json ? GetNestedStringFrom(*json, fieldPath, defaultValue) : defaultValue;
+}
+
 std::vector<nlohmann::json> JsonParser::ParseArray(const std::string& jsonString) {
     std::vector<nlohmann::json> result;
 
@@ -191,6 +232,161 @@ std::vector<nlohmann::json> JsonParser::ParseArray(const std::string& jsonString
     return result;
 }
 
+namespace {
+
+// SAX handler cho JsonParser::StreamArray: chỉ báo scalar ở depth-1 của
+// mỗi element trong mảng root; object/array lồng sâu hơn bị nuốt qua
+// skipDepth_ mà không sinh node DOM nào
+class FlatArraySax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit FlatArraySax(const JsonParser::StreamArrayCallbacks& cb) : cb_(cb) {}
+
+    bool RootWasArray() const { return rootIsArray_; }
+    bool StoppedEarly() const { return stopped_; }
+    bool HadParseError() const { return parseError_; }
+    const std::string& ErrorWhat() const { return errorWhat_; }
+
+    bool null() override { currentKey_.clear(); return true; }
+    bool boolean(bool) override { currentKey_.clear(); return true; }
+
+    bool number_integer(number_integer_t val) override {
+        EmitInt(static_cast<long long>(val));
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t val) override {
+        EmitInt(static_cast<long long>(val));
+        return true;
+    }
+    bool number_float(number_float_t, const string_t&) override {
+        currentKey_.clear();
+        return true;
+    }
+    bool string(string_t& val) override {
+        if (AtElementField() && cb_.onString) {
+            cb_.onString(currentKey_, val);
+        }
+        currentKey_.clear();
+        return true;
+    }
+    bool binary(binary_t&) override { currentKey_.clear(); return true; }
+
+    bool start_object(std::size_t) override {
+        if (!rootSeen_) {
+            return false; // Root là object, không phải mảng
+        }
+        if (inElement_) {
+            skipDepth_++; // Object lồng trong element - bỏ qua
+            return true;
+        }
+        inElement_ = true;
+        if (cb_.onElementStart) {
+            cb_.onElementStart();
+        }
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (inElement_ && skipDepth_ == 0) {
+            currentKey_ = val;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (skipDepth_ > 0) {
+            skipDepth_--;
+            return true;
+        }
+        inElement_ = false;
+        if (cb_.onElementEnd && !cb_.onElementEnd()) {
+            stopped_ = true; // Caller chủ động dừng - không phải lỗi
+            return false;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (!rootSeen_) {
+            rootSeen_ = true;
+            rootIsArray_ = true;
+            return true;
+        }
+        skipDepth_++; // Mảng lồng trong element - bỏ qua
+        return true;
+    }
+
+    bool end_array() override {
+        if (skipDepth_ > 0) {
+            skipDepth_--;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&,
+                     const nlohmann::detail::exception& ex) override {
+        parseError_ = true;
+        errorWhat_ = ex.what();
+        return false;
+    }
+
+private:
+    bool AtElementField() const {
+        return inElement_ && skipDepth_ == 0 && !currentKey_.empty();
+    }
+
+    void EmitInt(long long val) {
+        if (AtElementField() && cb_.onInt) {
+            cb_.onInt(currentKey_, val);
+        }
+        currentKey_.clear();
+    }
+
+    const JsonParser::StreamArrayCallbacks& cb_;
+    std::string currentKey_;
+    int skipDepth_ = 0;      // Đang ở trong cấu trúc lồng cần bỏ qua
+    bool rootSeen_ = false;
+    bool rootIsArray_ = false;
+    bool inElement_ = false; // Đang ở trong một element object của mảng root
+    bool stopped_ = false;
+    bool parseError_ = false;
+    std::string errorWhat_;
+};
+
+} // namespace
+
+bool JsonParser::StreamArray(const std::string& jsonString,
+                             const StreamArrayCallbacks& callbacks) {
+    if (jsonString.empty()) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::Json, ErrorSeverity::Warning,
+            "Empty JSON string provided", "JsonParser::StreamArray");
+        return false;
+    }
+
+    FlatArraySax sax(callbacks);
+    try {
+        nlohmann::json::sax_parse(jsonString, &sax);
+    } catch (const std::exception& e) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::Json, ErrorSeverity::Warning,
+            "Error streaming array: " + std::string(e.what()), "JsonParser::StreamArray");
+        return false;
+    }
+
+    if (sax.StoppedEarly()) {
+        return true; // Callback dừng sớm có chủ đích (delta refresh)
+    }
+    if (sax.HadParseError()) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::Json, ErrorSeverity::Warning,
+            "JSON parse error: " + sax.ErrorWhat(), "JsonParser::StreamArray");
+        return false;
+    }
+    if (!sax.RootWasArray()) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::Json, ErrorSeverity::Warning,
+            "JSON is not an array", "JsonParser::StreamArray");
+        return false;
+    }
+    return true;
+}
+
 std::string JsonParser::BuildJson(const std::vector<std::pair<std::string, std::string>>& pairs) {
     try {
         nlohmann::json json;
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <nlohmann/json.hpp>
 
 /**
@@ -20,6 +21,39 @@ public:
      */
     static std::unique_ptr<nlohmann::json> Parse(const std::string& jsonString);
 
+    /**
+     * ParsedDocument - Parse-once handle over a JSON payload
+     *
+     * The static getters below re-run nlohmann::json::parse on every call,
+     * which is wasteful when extracting several fields from the same body
+     * (health checks, send responses, settings files). ParsedDocument parses
+     * the payload once and answers typed getters against the retained DOM.
+     *
+     * Usage:
+     *   JsonParser::ParsedDocument doc(response);
+     *   if (doc.IsValid()) { auto model = doc.GetNestedString("llm.model"); }
+     */
+    class ParsedDocument {
+    public:
+        explicit ParsedDocument(const std::string& jsonString);
+
+        /** @return true if the payload parsed successfully */
+        bool IsValid() const { return json_ != nullptr; }
+
+        std::string GetString(const std::string& fieldName,
+                              const std::string& defaultValue = "") const;
+        int GetInt(const std::string& fieldName, int defaultValue = 0) const;
+        bool GetBool(const std::string& fieldName, bool defaultValue = false) const;
+        std::string GetNestedString(const std::string& fieldPath,
+                                    const std::string& defaultValue = "") const;
+
+        /** Direct access to the retained DOM (nullptr if invalid) */
+        const nlohmann::json* Raw() const { return json_.get(); }
+
+    private:
+        std::unique_ptr<nlohmann::json> json_;
+    };
+
     /**
      * Extract a string field from JSON
      * @param jsonString The JSON string
@@ -27,7 +61,7 @@ public:
      * @param defaultValue Default value if field not found or invalid
      * @return The field value, or defaultValue if not found/invalid
      */
-    static std::string GetString(const std::string& jsonString, 
+    static std::string GetString(const std::string& jsonString,
                                  const std::string& fieldName, 
                                  const std::string& defaultValue = "");
 
@@ -78,6 +112,36 @@ public:
      */
     static std::vector<nlohmann::json> ParseArray(const std::string& jsonString);
 
+    /**
+     * StreamArrayCallbacks - SAX extraction over a top-level JSON array
+     *
+     * ParseArray dựng DOM cho toàn bộ payload rồi copy từng element ra
+     * vector, trong khi caller thường chỉ cần vài field scalar của mỗi
+     * object. StreamArray chạy nlohmann sax_parse thẳng trên response
+     * buffer: không DOM trung gian, peak memory gần bằng 0 so với cỡ body.
+     *
+     * Chỉ field scalar ở depth-1 của mỗi element được báo qua callback;
+     * object/array lồng bên trong bị bỏ qua. Callback nào để trống thì
+     * loại field tương ứng bị bỏ qua luôn.
+     */
+    struct StreamArrayCallbacks {
+        std::function<void()> onElementStart;
+        std::function<void(const std::string& key, const std::string& value)> onString;
+        std::function<void(const std::string& key, long long value)> onInt;
+        // Trả false để dừng sớm (delta refresh) - StreamArray vẫn trả true
+        std::function<bool()> onElementEnd;
+    };
+
+    /**
+     * Stream qua các object của một mảng JSON không qua DOM (sax_parse)
+     * @param jsonString Body chứa mảng top-level
+     * @param callbacks Field/element callbacks (xem StreamArrayCallbacks)
+     * @return true nếu parse xong hoặc callback chủ động dừng;
+     *         false nếu parse lỗi hoặc root không phải mảng
+     */
+    static bool StreamArray(const std::string& jsonString,
+                            const StreamArrayCallbacks& callbacks);
+
     /**
      * Build a JSON object from key-value pairs
      * @param pairs Vector of key-value pairs
@@ -105,4 +169,20 @@ public:
      * @param errorMessage The error message to log
      */
     static void LogError(const std::string& errorMessage);
+
+private:
+    // Shared extraction logic working on an already-parsed DOM.
+    // Used by both the static one-shot getters and ParsedDocument.
+    static std::string GetStringFrom(const nlohmann::json& json,
+                                     const std::string& fieldName,
+                                     const std::string& defaultValue);
+    static int GetIntFrom(const nlohmann::json& json,
+                          const std::string& fieldName,
+                          int defaultValue);
+    static bool GetBoolFrom(const nlohmann::json& json,
+                            const std::string& fieldName,
+                            bool defaultValue);
+    static std::string GetNestedStringFrom(const nlohmann::json& json,
+                                           const std::string& fieldPath,
+                                           const std::string& defaultValue);
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "MetadataBlobStore.h"
+
+#pragma comment(lib, "cabinet.lib")
+
+MetadataBlobStore::MetadataBlobStore() {
+    // XPRESS+Huffman: tỉ lệ tốt trên JSON text mà nén/giải nén vẫn rẻ
+    // (tooltip giải nén trên UI thread). Fail (không nên xảy ra trên
+    // Windows 8+) thì Put rơi về lưu nguyên không nén.
+    if (!CreateCompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, NULL, &compressor_)) {
+        compressor_ = NULL;
+    }
+    if (!CreateDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, NULL, &decompressor_)) {
+        decompressor_ = NULL;
+    }
+}
+
+MetadataBlobStore::~MetadataBlobStore() {
+    if (compressor_) {
+        CloseCompressor(compressor_);
+    }
+    if (decompressor_) {
+        CloseDecompressor(decompressor_);
+    }
+}
+
+MetadataBlobStore::BlobId MetadataBlobStore::Put(const std::string& body) {
+    if (body.empty()) {
+        return 0;
+    }
+
+    Blob blob;
+    blob.originalSize = body.size();
+
+    if (compressor_ && decompressor_) {
+        // Hỏi size cần thiết trước (call đầu fail với ERROR_INSUFFICIENT_BUFFER)
+        SIZE_T bound = 0;
+        Compress(compressor_, (PVOID)body.data(), body.size(), NULL, 0, &bound);
+        if (bound > 0) {
+            blob.data.resize(bound);
+            SIZE_T actual = 0;
+            if (Compress(compressor_, (PVOID)body.data(), body.size(),
+                         blob.data.data(), bound, &actual) &&
+                actual > 0 && actual < body.size()) {
+                blob.data.resize(actual);
+                blob.data.shrink_to_fit();
+                blob.compressed = true;
+            }
+        }
+    }
+
+    if (!blob.compressed) {
+        // Nén không nhỏ hơn (body ngắn) hoặc không có compressor -> giữ nguyên
+        blob.data.assign(body.begin(), body.end());
+    }
+
+    totalStoredBytes_ += blob.data.size();
+    BlobId id = nextId_++;
+    blobs_.emplace(id, std::move(blob));
+    return id;
+}
+
+std::string MetadataBlobStore::Get(BlobId id) const {
+    auto it = blobs_.find(id);
+    if (it == blobs_.end()) {
+        return std::string();
+    }
+
+    const Blob& blob = it->second;
+    if (!blob.compressed) {
+        return std::string(blob.data.begin(), blob.data.end());
+    }
+
+    std::string out(blob.originalSize, '\0');
+    SIZE_T actual = 0;
+    if (!decompressor_ ||
+        !Decompress(decompressor_, (PVOID)blob.data.data(), blob.data.size(),
+                    &out[0], out.size(), &actual)) {
+        return std::string();
+    }
+    out.resize(actual);
+    return out;
+}
+
+void MetadataBlobStore::Clear() {
+    blobs_.clear();
+    totalStoredBytes_ = 0;
+    // nextId_ cứ tăng tiếp: BlobId cũ còn sót trong message nào đó sẽ
+    // miss chứ không bao giờ trỏ nhầm vào blob mới
+}
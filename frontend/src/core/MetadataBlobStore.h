@@ -0,0 +1,57 @@
+#pragma once
+#include <windows.h>
+#include <compressapi.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * MetadataBlobStore - lưu nén body response gốc của từng message
+ *
+ * Trước đây MessageMetadata.rawJson giữ nguyên full response body dạng
+ * plain text suốt vòng đời conversation, chỉ để tooltip có thể hiện chi
+ * tiết - session dài cả ngày nhân đôi nhiều MB JSON trong RAM mà gần như
+ * không bao giờ đọc. Các field tooltip cần (tokens/latency/model) đã được
+ * extract sẵn vào MessageMetadata; body gốc giờ nén XPRESS+Huffman
+ * (Compression API của Windows, rất nhanh trên JSON text) vào đây và chỉ
+ * giải nén on demand khi tooltip thật sự cần (Get).
+ *
+ * Message giữ BlobId (0 = không có blob) thay vì chuỗi. Clear() khi
+ * transcript bị thay (session mới / load session khác) để blob của
+ * message đã biến mất không tích tụ. Chỉ dùng từ UI thread nên không lock.
+ */
+class MetadataBlobStore {
+public:
+    using BlobId = uint32_t; // 0 = không có blob
+
+    MetadataBlobStore();
+    ~MetadataBlobStore();
+
+    MetadataBlobStore(const MetadataBlobStore&) = delete;
+    MetadataBlobStore& operator=(const MetadataBlobStore&) = delete;
+
+    /** Nén và lưu body, trả về handle (0 nếu body rỗng) */
+    BlobId Put(const std::string& body);
+
+    /** Giải nén body theo handle; chuỗi rỗng nếu không có/giải nén fail */
+    std::string Get(BlobId id) const;
+
+    /** Bỏ toàn bộ blob (transcript bị thay bằng nội dung khác) */
+    void Clear();
+
+    size_t TotalStoredBytes() const { return totalStoredBytes_; }
+
+private:
+    struct Blob {
+        std::vector<unsigned char> data;
+        size_t originalSize = 0;
+        bool compressed = false; // false = giữ nguyên (nén không nhỏ hơn/không có API)
+    };
+
+    COMPRESSOR_HANDLE compressor_ = NULL;
+    DECOMPRESSOR_HANDLE decompressor_ = NULL;
+    std::unordered_map<BlobId, Blob> blobs_;
+    BlobId nextId_ = 1;
+    size_t totalStoredBytes_ = 0;
+};
@@ -0,0 +1,124 @@
+#include "PerfMetrics.h"
+#include "ErrorHandler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+PerfMetrics& PerfMetrics::GetInstance() {
+    static PerfMetrics instance;
+    return instance;
+}
+
+double PerfMetrics::TicksToMs(long long ticks) {
+    static LARGE_INTEGER freq = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return f;
+    }();
+    return (double)ticks * 1000.0 / (double)freq.QuadPart;
+}
+
+int PerfMetrics::BucketFor(double ms) {
+    if (ms < 1.0) {
+        return 0;
+    }
+    int bucket = 1 + (int)std::floor(std::log2(ms));
+    return (bucket >= BUCKET_COUNT) ? BUCKET_COUNT - 1 : bucket;
+}
+
+void PerfMetrics::Record(const char* name, double ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metric& m = metrics_[name];
+    if (m.count == 0 || ms < m.minMs) m.minMs = ms;
+    if (m.count == 0 || ms > m.maxMs) m.maxMs = ms;
+    m.count++;
+    m.sumMs += ms;
+    m.buckets[BucketFor(ms)]++;
+}
+
+double PerfMetrics::PercentileFrom(const Metric& m, double fraction) {
+    if (m.count == 0) {
+        return 0.0;
+    }
+    // Tìm bucket chứa sample thứ rank, trả về cận trên của bucket
+    // (xấp xỉ ~2x nhưng đủ để thấy p99 nhảy vọt giữa các release)
+    long long rank = (long long)std::ceil(fraction * (double)m.count);
+    if (rank < 1) rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += m.buckets[i];
+        if (seen >= rank) {
+            double upper = (i == 0) ? 1.0 : std::pow(2.0, i);
+            return (upper > m.maxMs) ? m.maxMs : upper;
+        }
+    }
+    return m.maxMs;
+}
+
+std::vector<PerfMetrics::Snapshot> PerfMetrics::GetSnapshots() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Snapshot> result;
+    result.reserve(metrics_.size());
+    for (const auto& [name, m] : metrics_) {
+        Snapshot s;
+        s.name = name;
+        s.count = m.count;
+        s.avgMs = (m.count > 0) ? m.sumMs / (double)m.count : 0.0;
+        s.minMs = m.minMs;
+        s.maxMs = m.maxMs;
+        s.p50Ms = PercentileFrom(m, 0.50);
+        s.p95Ms = PercentileFrom(m, 0.95);
+        s.p99Ms = PercentileFrom(m, 0.99);
+        result.push_back(std::move(s));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Snapshot& a, const Snapshot& b) { return a.name < b.name; });
+    return result;
+}
+
+void PerfMetrics::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.clear();
+}
+
+std::string PerfMetrics::DumpToFile() {
+    // Đặt cạnh log của ErrorHandler để cùng một chỗ thu thập từ field
+    std::string logPath = ErrorHandler::GetInstance().GetLogFilePath();
+    std::string dir;
+    size_t slash = logPath.find_last_of("\\/");
+    if (slash != std::string::npos) {
+        dir = logPath.substr(0, slash + 1);
+    }
+    std::string outPath = dir + "perf_metrics.txt";
+
+    auto snapshots = GetSnapshots();
+
+    std::ofstream out(outPath, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        ErrorHandler::GetInstance().LogError(ErrorCategory::System, ErrorSeverity::Warning,
+            "Failed to write perf metrics to " + outPath, "PerfMetrics::DumpToFile");
+        return "";
+    }
+
+    out << "SenAI frontend perf metrics (ms)\n";
+    out << std::left << std::setw(28) << "metric"
+        << std::right << std::setw(10) << "count"
+        << std::setw(10) << "avg" << std::setw(10) << "min" << std::setw(10) << "max"
+        << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99"
+        << "\n";
+    out << std::fixed << std::setprecision(2);
+    for (const auto& s : snapshots) {
+        out << std::left << std::setw(28) << s.name
+            << std::right << std::setw(10) << s.count
+            << std::setw(10) << s.avgMs << std::setw(10) << s.minMs
+            << std::setw(10) << s.maxMs << std::setw(10) << s.p50Ms
+            << std::setw(10) << s.p95Ms << std::setw(10) << s.p99Ms << "\n";
+    }
+    out.close();
+
+    ErrorHandler::GetInstance().LogError(ErrorCategory::System, ErrorSeverity::Info,
+        "Perf metrics dumped to " + outPath, "PerfMetrics::DumpToFile");
+    return outPath;
+}
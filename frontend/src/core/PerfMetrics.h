@@ -0,0 +1,104 @@
+#pragma once
+
+#include <windows.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * PerfMetrics - Lightweight client-side performance instrumentation
+ *
+ * MessageMetadata chỉ có latencyMs do backend trả về; bản thân client
+ * không đo gì cả nên "app chậm" ngoài field không có số liệu. PerfMetrics
+ * gom sample thời gian (ms) theo tên metric vào histogram log2 cố định,
+ * từ đó trả về count/avg/min/max và percentile xấp xỉ (p50/p95/p99).
+ *
+ * Ghi sample qua ScopedTimer (RAII quanh một scope) hoặc Record trực tiếp.
+ * Thread-safe: worker thread của HttpClient ghi song song với UI thread,
+ * mỗi Record chỉ là QueryPerformanceCounter + vài phép cộng dưới mutex.
+ *
+ * Hiển thị: MainWindow vẽ HUD overlay trong OnPaint (toggle Ctrl+Shift+P)
+ * từ GetSnapshots(); DumpToFile ghi report cạnh log của ErrorHandler để
+ * thu thập từ máy người dùng.
+ */
+class PerfMetrics {
+public:
+    static PerfMetrics& GetInstance();
+
+    /** Ghi một sample (milliseconds) cho metric `name` */
+    void Record(const char* name, double ms);
+
+    /** Số liệu tổng hợp của một metric tại thời điểm snapshot */
+    struct Snapshot {
+        std::string name;
+        long long count = 0;
+        double avgMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+    };
+
+    /** Snapshot mọi metric, sắp theo tên (ổn định cho HUD) */
+    std::vector<Snapshot> GetSnapshots() const;
+
+    /** Xoá toàn bộ sample đã gom */
+    void Reset();
+
+    /**
+     * Ghi report dạng text cạnh log file của ErrorHandler
+     * (perf_metrics.txt cùng thư mục). Trả về đường dẫn, rỗng nếu lỗi.
+     */
+    std::string DumpToFile();
+
+    /**
+     * ScopedTimer - đo thời gian sống của scope và Record khi huỷ.
+     * `name` phải là string literal (không copy).
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const char* name) : name_(name) {
+            QueryPerformanceCounter(&start_);
+        }
+        ~ScopedTimer() {
+            LARGE_INTEGER end;
+            QueryPerformanceCounter(&end);
+            PerfMetrics::GetInstance().Record(
+                name_, TicksToMs(end.QuadPart - start_.QuadPart));
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const char* name_;
+        LARGE_INTEGER start_;
+    };
+
+private:
+    PerfMetrics() = default;
+    ~PerfMetrics() = default;
+    PerfMetrics(const PerfMetrics&) = delete;
+    PerfMetrics& operator=(const PerfMetrics&) = delete;
+
+    static double TicksToMs(long long ticks);
+
+    // Histogram log2: bucket i chứa sample trong [2^(i-1), 2^i) ms,
+    // bucket 0 là < 1ms. 20 bucket phủ tới ~8.7 phút - quá đủ cho UI/network.
+    static constexpr int BUCKET_COUNT = 20;
+
+    struct Metric {
+        long long count = 0;
+        double sumMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        long long buckets[BUCKET_COUNT] = {};
+    };
+
+    static int BucketFor(double ms);
+    static double PercentileFrom(const Metric& m, double fraction);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Metric> metrics_;
+};
@@ -0,0 +1,108 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <cwctype>
+
+void SearchIndex::Clear() {
+    entries_.clear();
+    trigrams_.clear();
+}
+
+std::wstring SearchIndex::FoldText(const std::wstring& text) {
+    std::wstring folded = text;
+    std::transform(folded.begin(), folded.end(), folded.begin(), towlower);
+    return folded;
+}
+
+unsigned long long SearchIndex::TrigramKey(const std::wstring& folded, size_t pos) {
+    // wchar_t trên Windows là 16 bit nên 3 ký tự vừa khít 48 bit
+    return (static_cast<unsigned long long>(folded[pos])) |
+           (static_cast<unsigned long long>(folded[pos + 1]) << 16) |
+           (static_cast<unsigned long long>(folded[pos + 2]) << 32);
+}
+
+void SearchIndex::IndexTrigrams(const std::wstring& folded, int entryIndex) {
+    if (folded.length() < 3) {
+        return;
+    }
+    for (size_t i = 0; i + 3 <= folded.length(); ++i) {
+        auto& postings = trigrams_[TrigramKey(folded, i)];
+        // Một entry thường lặp lại trigram nhiều lần; chỉ cần ghi một lần
+        if (postings.empty() || postings.back() != entryIndex) {
+            postings.push_back(entryIndex);
+        }
+    }
+}
+
+void SearchIndex::SyncEntry(size_t index, const std::wstring& text) {
+    if (index >= entries_.size()) {
+        entries_.resize(index + 1);
+    }
+
+    Entry& entry = entries_[index];
+    if (entry.sourceLength == text.length()) {
+        return; // Không đổi (heuristic độ dài, giống MessageLayout)
+    }
+
+    entry.foldedText = FoldText(text);
+    entry.sourceLength = text.length();
+    IndexTrigrams(entry.foldedText, static_cast<int>(index));
+}
+
+std::vector<int> SearchIndex::FindMatchingEntries(const std::wstring& foldedQuery) const {
+    std::vector<int> results;
+    if (foldedQuery.empty()) {
+        return results;
+    }
+
+    if (foldedQuery.length() < 3) {
+        // Query quá ngắn cho trigram: scan folded text đã cache
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].foldedText.find(foldedQuery) != std::wstring::npos) {
+                results.push_back(static_cast<int>(i));
+            }
+        }
+        return results;
+    }
+
+    // Chọn posting list ngắn nhất trong các trigram của query làm candidate set;
+    // thiếu bất kỳ trigram nào nghĩa là không thể có match
+    const std::vector<int>* shortest = nullptr;
+    for (size_t i = 0; i + 3 <= foldedQuery.length(); ++i) {
+        auto it = trigrams_.find(TrigramKey(foldedQuery, i));
+        if (it == trigrams_.end()) {
+            return results;
+        }
+        if (!shortest || it->second.size() < shortest->size()) {
+            shortest = &it->second;
+        }
+    }
+
+    // Posting list có thể chứa id trùng (sau update) -> sort + unique rồi verify
+    std::vector<int> candidates = *shortest;
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (int candidate : candidates) {
+        if (candidate >= 0 && static_cast<size_t>(candidate) < entries_.size() &&
+            entries_[candidate].foldedText.find(foldedQuery) != std::wstring::npos) {
+            results.push_back(candidate);
+        }
+    }
+    return results;
+}
+
+std::vector<std::pair<size_t, size_t>> SearchIndex::FindMatchesIn(size_t index,
+                                                                  const std::wstring& foldedQuery) const {
+    std::vector<std::pair<size_t, size_t>> matches;
+    if (foldedQuery.empty() || index >= entries_.size()) {
+        return matches;
+    }
+
+    const std::wstring& folded = entries_[index].foldedText;
+    size_t pos = 0;
+    while ((pos = folded.find(foldedQuery, pos)) != std::wstring::npos) {
+        matches.push_back({pos, pos + foldedQuery.length()});
+        pos += foldedQuery.length();
+    }
+    return matches;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * SearchIndex - Incremental full-text index for chat message search
+ *
+ * PerformSearch used to lowercase every message with towlower on every
+ * keystroke, which re-folds the entire transcript each time the query
+ * changes. SearchIndex keeps a case-folded copy of each message (folded
+ * once, when the message is added or its text changes) plus a trigram
+ * posting-list index, so a search only touches the candidate entries
+ * whose trigrams match the query.
+ *
+ * Queries shorter than 3 characters fall back to a scan over the cached
+ * folded texts — still no per-keystroke re-folding of message content.
+ *
+ * Entries are addressed by index and mirror chatViewState_.messages;
+ * the owner calls SyncEntry for each message before searching (cheap
+ * length comparison when nothing changed) and Clear when the transcript
+ * is replaced.
+ */
+class SearchIndex {
+public:
+    void Clear();
+    size_t Size() const { return entries_.size(); }
+
+    /**
+     * Đồng bộ entry với text nguồn: entry mới hoặc độ dài đổi thì fold
+     * và index lại; còn lại chỉ là một phép so sánh int.
+     */
+    void SyncEntry(size_t index, const std::wstring& text);
+
+    /**
+     * Trả về index (tăng dần) của mọi entry chứa foldedQuery.
+     * foldedQuery phải đi qua FoldText trước.
+     */
+    std::vector<int> FindMatchingEntries(const std::wstring& foldedQuery) const;
+
+    /**
+     * Vị trí (start, end) của từng match trong entry — dùng folded text
+     * đã cache, không fold lại text nguồn. foldedQuery như trên.
+     */
+    std::vector<std::pair<size_t, size_t>> FindMatchesIn(size_t index,
+                                                         const std::wstring& foldedQuery) const;
+
+    /** Case-fold một chuỗi (towlower từng ký tự, giữ nguyên độ dài/vị trí) */
+    static std::wstring FoldText(const std::wstring& text);
+
+private:
+    struct Entry {
+        std::wstring foldedText;
+        size_t sourceLength = 0; // Độ dài text nguồn lúc fold (heuristic đổi text)
+    };
+
+    // 3 wchar_t liên tiếp đóng gói vào 48 bit làm key posting list
+    static unsigned long long TrigramKey(const std::wstring& folded, size_t pos);
+    void IndexTrigrams(const std::wstring& folded, int entryIndex);
+
+    std::vector<Entry> entries_;
+    // Posting lists: trigram -> entry ids. Sau khi một entry bị update, list
+    // có thể chứa id trùng hoặc trigram cũ (không gỡ ra để update rẻ);
+    // FindMatchingEntries luôn verify bằng find trên folded text nên kết quả
+    // không bị ảnh hưởng.
+    std::unordered_map<unsigned long long, std::vector<int>> trigrams_;
+};
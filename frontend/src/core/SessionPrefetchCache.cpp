@@ -0,0 +1,53 @@
+#include "SessionPrefetchCache.h"
+
+const std::string* SessionPrefetchCache::Get(const std::string& sessionId) {
+    auto it = index_.find(sessionId);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    // Hit -> chuyển lên đầu danh sách MRU
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+}
+
+bool SessionPrefetchCache::Contains(const std::string& sessionId) const {
+    return index_.find(sessionId) != index_.end();
+}
+
+void SessionPrefetchCache::Put(const std::string& sessionId, std::string body) {
+    auto it = index_.find(sessionId);
+    if (it != index_.end()) {
+        // Ghi đè entry cũ (prefetch lại sau khi transcript đổi)
+        totalBytes_ -= it->second->second.size();
+        totalBytes_ += body.size();
+        it->second->second = std::move(body);
+        entries_.splice(entries_.begin(), entries_, it->second);
+    } else {
+        totalBytes_ += body.size();
+        entries_.emplace_front(sessionId, std::move(body));
+        index_[sessionId] = entries_.begin();
+    }
+    EvictWhileOverBudget();
+}
+
+void SessionPrefetchCache::Erase(const std::string& sessionId) {
+    auto it = index_.find(sessionId);
+    if (it == index_.end()) {
+        return;
+    }
+    totalBytes_ -= it->second->second.size();
+    entries_.erase(it->second);
+    index_.erase(it);
+}
+
+void SessionPrefetchCache::EvictWhileOverBudget() {
+    // Đuổi từ đuôi (ít dùng nhất) cho tới khi cả hai trần đều thỏa.
+    // Entry vừa Put không bao giờ bị đuổi ngay (luôn ở đầu danh sách).
+    while (entries_.size() > 1 &&
+           (entries_.size() > MAX_SESSIONS || totalBytes_ > MAX_TOTAL_BYTES)) {
+        const auto& victim = entries_.back();
+        totalBytes_ -= victim.second.size();
+        index_.erase(victim.first);
+        entries_.pop_back();
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * SessionPrefetchCache - LRU cache transcript đã prefetch khi hover sidebar
+ *
+ * Giữ raw JSON body của GET /conversations?session_id=... cho một nhóm nhỏ
+ * session được hover gần đây. Click vào item đã prefetch thì
+ * LoadConversationBySessionId parse thẳng từ đây - không còn round-trip
+ * blocking cho thao tác điều hướng phổ biến nhất.
+ *
+ * Eviction theo hai trần: số session (MAX_SESSIONS) và tổng byte
+ * (MAX_TOTAL_BYTES) - một session dài bất thường không thể giữ cache
+ * phình to vô hạn. Chỉ dùng từ UI thread nên không cần lock.
+ */
+class SessionPrefetchCache {
+public:
+    /** Body đã cache, hoặc nullptr nếu miss. Hit được đánh dấu MRU. */
+    const std::string* Get(const std::string& sessionId);
+
+    /** true nếu session đang có trong cache (không đổi thứ tự LRU) */
+    bool Contains(const std::string& sessionId) const;
+
+    /** Thêm/ghi đè body cho session rồi evict nếu vượt trần */
+    void Put(const std::string& sessionId, std::string body);
+
+    /** Bỏ một session (transcript phía backend đã đổi - vd gửi message mới) */
+    void Erase(const std::string& sessionId);
+
+    size_t TotalBytes() const { return totalBytes_; }
+
+private:
+    static const size_t MAX_SESSIONS = 8;
+    static const size_t MAX_TOTAL_BYTES = 8 * 1024 * 1024;
+
+    void EvictWhileOverBudget();
+
+    // front = dùng gần nhất (cùng pattern với measureLru_ của GDIResourceManager)
+    std::list<std::pair<std::string, std::string>> entries_;
+    std::unordered_map<std::string,
+                       std::list<std::pair<std::string, std::string>>::iterator> index_;
+    size_t totalBytes_ = 0;
+};
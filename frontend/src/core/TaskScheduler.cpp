@@ -0,0 +1,86 @@
+#include "TaskScheduler.h"
+#include <algorithm>
+
+TaskScheduler& TaskScheduler::GetInstance() {
+    static TaskScheduler instance;
+    return instance;
+}
+
+TaskScheduler::TaskScheduler() {
+    // Tối thiểu 2 worker: một SSE stream đang chạy dài không được chặn
+    // health check / refresh phía sau
+    unsigned int poolSize = std::max(2u, std::thread::hardware_concurrency());
+    workers_.reserve(poolSize);
+    for (unsigned int i = 0; i < poolSize; i++) {
+        workers_.emplace_back(&TaskScheduler::WorkerLoop, this);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    Shutdown();
+}
+
+void TaskScheduler::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        // Task chưa chạy bị bỏ - shutdown không chờ prefetch/polling;
+        // task đang chạy dở được join bên dưới
+        userBlockingQueue_.clear();
+        prefetchQueue_.clear();
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear(); // Lần gọi thứ hai (từ destructor) thành no-op
+}
+
+void TaskScheduler::Post(TaskPriority priority, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        if (priority == TaskPriority::UserBlocking) {
+            userBlockingQueue_.push_back(std::move(task));
+        } else {
+            prefetchQueue_.push_back(std::move(task));
+        }
+    }
+    cv_.notify_one();
+}
+
+void TaskScheduler::WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return stopping_ || !userBlockingQueue_.empty() || !prefetchQueue_.empty();
+            });
+            if (stopping_) {
+                return;
+            }
+            // UserBlocking lane trước, Prefetch chỉ khi lane trên rỗng
+            if (!userBlockingQueue_.empty()) {
+                task = std::move(userBlockingQueue_.front());
+                userBlockingQueue_.pop_front();
+            } else {
+                task = std::move(prefetchQueue_.front());
+                prefetchQueue_.pop_front();
+            }
+        }
+        task();
+    }
+}
+
+void TaskScheduler::PostResultToWindow(HWND hwnd, UINT msg, UINT_PTR requestId,
+                                       std::string payload) {
+    auto* result = new std::string(std::move(payload));
+    if (!PostMessageW(hwnd, msg, (WPARAM)requestId, (LPARAM)result)) {
+        delete result; // Window đã bị hủy, tự dọn dẹp
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <windows.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Lane ưu tiên của một task. Worker luôn lấy hết UserBlocking trước khi
+ * đụng tới Prefetch, nên prefetch/polling không bao giờ chen trước công
+ * việc user đang chờ.
+ */
+enum class TaskPriority {
+    UserBlocking,   // User đang nhìn spinner chờ kết quả (send, sidebar...)
+    Prefetch        // Nền: health polling, prefetch, việc làm trước cho rẻ
+};
+
+/**
+ * TaskScheduler - worker pool dùng chung cho mọi background work
+ *
+ * Trước đây mỗi async call của HttpClient tự spawn một detached
+ * std::thread; số thread không bounded và mỗi chỗ tự lo marshaling.
+ * TaskScheduler giữ một pool cố định (hardware_concurrency, tối thiểu 2)
+ * với hai lane ưu tiên; mọi chỗ cần chạy nền đều Post vào đây nên tổng
+ * thread count của app là hằng số.
+ *
+ * Kết quả trả về UI thread qua PostResultToWindow - cùng contract
+ * PostMessageW(hwnd, msg, requestId, new std::string) mà các handler
+ * On*Complete đã dùng (receiver delete qua unique_ptr).
+ *
+ * Task không có cơ chế cancel riêng: caller tự kiểm tra staleness như
+ * trước (generation counter của HttpClient, requestId ở window handler).
+ * Task chạy dài (SSE stream) chiếm một worker trong suốt thời gian đó -
+ * chấp nhận được vì mỗi lúc chỉ có một stream.
+ */
+class TaskScheduler {
+public:
+    static TaskScheduler& GetInstance();
+
+    /** Xếp task vào lane tương ứng; chạy trên một worker của pool */
+    void Post(TaskPriority priority, std::function<void()> task);
+
+    /**
+     * Marshal một chuỗi kết quả về window (heap-allocated, receiver
+     * delete). Tự dọn dẹp nếu window đã bị hủy.
+     */
+    static void PostResultToWindow(HWND hwnd, UINT msg, UINT_PTR requestId,
+                                   std::string payload);
+
+    /**
+     * Hạ pool một cách chủ động: bỏ task chưa chạy, join task đang chạy
+     * dở. Phải gọi TRƯỚC khi các object mà task capture (HttpClient là
+     * member của MainWindow trên stack WinMain) bị hủy - để mặc tới
+     * static destruction là quá muộn, worker có thể đang deref con trỏ
+     * đã chết. Idempotent; Post sau khi Shutdown là no-op.
+     */
+    void Shutdown();
+
+private:
+    TaskScheduler();
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> userBlockingQueue_;
+    std::deque<std::function<void()>> prefetchQueue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
@@ -45,6 +45,7 @@ enum StringID {
     IDS_EXPORT_ERROR,
     IDS_EXPORT_ERROR_NO_MESSAGES,
     IDS_EXPORT_ERROR_FILE_WRITE,
+    IDS_EXPORT_PROGRESS,
     // Add more as needed
 };
 
@@ -94,6 +95,7 @@ public:
         strings_[IDS_EXPORT_ERROR] = L"Lỗi khi xuất file";
         strings_[IDS_EXPORT_ERROR_NO_MESSAGES] = L"Không có tin nhắn để xuất";
         strings_[IDS_EXPORT_ERROR_FILE_WRITE] = L"Không thể ghi file";
+        strings_[IDS_EXPORT_PROGRESS] = L"Đang xuất… %zu hội thoại, %zu phiên";
     }
 
     // Get string by ID
@@ -0,0 +1,86 @@
+#include "UpdateChannel.h"
+#include "HttpClient.h"
+#include "JsonParser.h"
+#include <chrono>
+
+namespace {
+
+// Server giữ request tối đa chừng này rồi trả "không đổi"; phải nhỏ hơn
+// receive timeout 30s của httpGetInternal để vòng poll không bị coi là lỗi
+constexpr int POLL_TIMEOUT_SEC = 20;
+
+// Backoff khi poll lỗi (backend chết/mạng đứt), cùng dáng với health check
+constexpr UINT ERROR_BASE_BACKOFF_MS = 5000;
+constexpr UINT ERROR_MAX_BACKOFF_MS = 120000;
+
+} // namespace
+
+UpdateChannel::UpdateChannel(HttpClient& httpClient, HWND notifyWnd, UINT changeMsg)
+    : httpClient_(httpClient), notifyWnd_(notifyWnd), changeMsg_(changeMsg) {
+    poller_ = std::thread(&UpdateChannel::PollLoop, this);
+}
+
+UpdateChannel::~UpdateChannel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_.store(true, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+    // Request long-poll đang bay có thể còn nằm chờ trên server tới
+    // POLL_TIMEOUT_SEC nữa - abort để join trả về ngay thay vì treo
+    // shutdown hết timeout (chỉ hủy UpdateChannel lúc WM_DESTROY nên đóng
+    // connection dùng chung không ảnh hưởng ai khác)
+    httpClient_.abortPendingRequests();
+    if (poller_.joinable()) {
+        poller_.join();
+    }
+}
+
+void UpdateChannel::NotifySeenId(int id) {
+    // Chỉ nâng lên: kết quả refresh về trễ không được kéo mốc lùi lại
+    int current = lastSeenId_.load(std::memory_order_relaxed);
+    while (id > current &&
+           !lastSeenId_.compare_exchange_weak(current, id, std::memory_order_relaxed)) {
+    }
+}
+
+void UpdateChannel::PollLoop() {
+    UINT backoffMs = 0; // 0 = poll lại ngay (vòng trước thành công)
+
+    for (;;) {
+        if (backoffMs > 0) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(backoffMs), [this] {
+                return stopping_.load(std::memory_order_relaxed);
+            });
+        }
+        if (stopping_.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        int after = lastSeenId_.load(std::memory_order_relaxed);
+        std::string body = httpClient_.pollConversationUpdates(after, POLL_TIMEOUT_SEC);
+
+        if (stopping_.load(std::memory_order_relaxed)) {
+            break; // Không post về window có thể đã bị hủy
+        }
+
+        if (body.empty() || body.find("Error:") == 0) {
+            backoffMs = (backoffMs == 0) ? ERROR_BASE_BACKOFF_MS : backoffMs * 2;
+            if (backoffMs > ERROR_MAX_BACKOFF_MS) {
+                backoffMs = ERROR_MAX_BACKOFF_MS;
+            }
+            continue;
+        }
+        backoffMs = 0;
+
+        JsonParser::ParsedDocument doc(body);
+        int latest = doc.GetInt("latest_id");
+        if (doc.GetBool("changed") && latest > after) {
+            NotifySeenId(latest);
+            PostMessageW(notifyWnd_, changeMsg_, 0, (LPARAM)latest);
+        }
+        // "Không đổi" (hết timeout phía server) -> poll lại ngay, request
+        // kế tiếp lại nằm chờ trên server
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class HttpClient;
+
+/**
+ * UpdateChannel - kênh push long-poll thay cho refresh định kỳ
+ *
+ * RefreshConversations trước đây thuần pull: hoặc poll (tốn một lượt fetch
+ * dù không có gì đổi) hoặc chấp nhận sidebar cũ. UpdateChannel giữ một
+ * request GET /conversations/updates?after_id=N mở trên thread riêng;
+ * backend trả về ngay khi có conversation mới hơn N (hoặc hết timeout thì
+ * trả "không đổi" và client poll lại). Có thay đổi thì:
+ *
+ *   PostMessageW(notifyWnd, changeMsg, 0, (LPARAM) latestId)
+ *
+ * và MainWindow chạy delta refresh (chỉ fetch phần đầu mới). Nhờ vậy một
+ * instance khác (hoặc backend tự tạo conversation) hiện lên sidebar trong
+ * vòng ~1s mà không tốn full-payload poll nào.
+ *
+ * Request long-poll chiếm connection trong suốt timeout nên chạy trên
+ * thread riêng như AnimationDriver, không đi qua TaskScheduler (sẽ chiếm
+ * một worker của pool 2 worker vô thời hạn). Backend lỗi/chết thì backoff
+ * lũy thừa như health check rồi thử lại.
+ */
+class UpdateChannel {
+public:
+    UpdateChannel(HttpClient& httpClient, HWND notifyWnd, UINT changeMsg);
+    ~UpdateChannel();
+
+    /**
+     * Nâng mốc id đã thấy (không bao giờ hạ xuống). MainWindow gọi sau mỗi
+     * lượt refresh để long-poll không báo lại thay đổi đã được merge.
+     */
+    void NotifySeenId(int id);
+
+private:
+    void PollLoop();
+
+    HttpClient& httpClient_;
+    HWND notifyWnd_;
+    UINT changeMsg_;
+    std::thread poller_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> lastSeenId_{0};
+};
@@ -0,0 +1,100 @@
+#include "AnimationDriver.h"
+
+namespace {
+
+// ~60Hz; đơn vị 100ns, âm = relative time cho SetWaitableTimer
+constexpr LONGLONG FRAME_INTERVAL_100NS = 10000000LL / 60;
+
+} // namespace
+
+AnimationDriver::AnimationDriver(HWND hwnd, UINT frameMsg)
+    : hwnd_(hwnd), frameMsg_(frameMsg) {
+    pump_ = std::thread(&AnimationDriver::PumpLoop, this);
+}
+
+AnimationDriver::~AnimationDriver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_.store(true, std::memory_order_relaxed);
+        running_.store(false, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+    if (pump_.joinable()) {
+        pump_.join();
+    }
+}
+
+void AnimationDriver::Start() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        framePending_.store(false, std::memory_order_relaxed);
+        running_.store(true, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+}
+
+void AnimationDriver::Stop() {
+    running_.store(false, std::memory_order_relaxed);
+}
+
+void AnimationDriver::PumpLoop() {
+    // High-resolution waitable timer (Windows 10 1803+); fallback timer
+    // thường vẫn tốt hơn WM_TIMER vì không bị coalesce trong message queue
+    HANDLE timer = CreateWaitableTimerExW(NULL, NULL,
+                                          CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                          TIMER_ALL_ACCESS);
+    if (!timer) {
+        timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    }
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return running_.load(std::memory_order_relaxed) ||
+                       stopping_.load(std::memory_order_relaxed);
+            });
+        }
+        if (stopping_.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        // Mốc delta-time là frame đã POST gần nhất - frame bị coalesce
+        // (UI bận) dồn thời gian của nó vào frame kế tiếp
+        LARGE_INTEGER lastPosted;
+        QueryPerformanceCounter(&lastPosted);
+
+        while (running_.load(std::memory_order_relaxed) &&
+               !stopping_.load(std::memory_order_relaxed)) {
+            if (timer) {
+                LARGE_INTEGER due;
+                due.QuadPart = -FRAME_INTERVAL_100NS;
+                SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE);
+                WaitForSingleObject(timer, 50);
+            } else {
+                Sleep(16);
+            }
+
+            if (framePending_.load(std::memory_order_acquire)) {
+                continue; // Frame trước chưa được xử lý -> coalesce
+            }
+
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            LONGLONG dtMicros = (now.QuadPart - lastPosted.QuadPart) * 1000000LL / freq.QuadPart;
+            lastPosted = now;
+
+            framePending_.store(true, std::memory_order_release);
+            if (!PostMessageW(hwnd_, frameMsg_, (WPARAM)dtMicros, 0)) {
+                framePending_.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    if (timer) {
+        CloseHandle(timer);
+    }
+}
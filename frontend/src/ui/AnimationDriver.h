@@ -0,0 +1,58 @@
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * AnimationDriver - frame pump độ phân giải cao cho animation
+ *
+ * Animation input trước đây chạy bằng SetTimer 15ms, nhưng WM_TIMER chỉ có
+ * độ phân giải ~15.6ms và bị coalesce khi message queue bận nên chuyển động
+ * giật cục. AnimationDriver dùng một thread riêng với waitable timer
+ * high-resolution (CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, fallback timer
+ * thường trên Windows cũ) phát frame message ~60Hz về window:
+ *
+ *   PostMessageW(hwnd, frameMsg, deltaTimeMicroseconds, 0)
+ *
+ * Delta time đo bằng QueryPerformanceCounter từ frame đã POST trước đó,
+ * nên phía nhận nội suy theo thời gian thực và không phụ thuộc tick đều.
+ * Backpressure: chỉ một frame message bay trong queue tại một thời điểm
+ * (UI gọi AcknowledgeFrame khi xử lý xong); UI bận thì frame bị dồn vào
+ * delta của frame kế tiếp thay vì chất đống message.
+ *
+ * Đây là thread pacing chuyên dụng (ngủ theo nhịp vsync-ish), không phải
+ * task ngắn - không đi qua TaskScheduler để khỏi chiếm worker vô hạn.
+ * Một driver phục vụ được nhiều hiệu ứng cùng lúc (input slide hôm nay,
+ * kinetic scrolling sau này): Start khi có hiệu ứng chạy, Stop khi hết.
+ */
+class AnimationDriver {
+public:
+    AnimationDriver(HWND hwnd, UINT frameMsg);
+    ~AnimationDriver();
+
+    /** Bắt đầu phát frame messages (no-op nếu đang chạy) */
+    void Start();
+
+    /** Ngừng phát (frame đã bay vẫn có thể tới sau đó) */
+    void Stop();
+
+    /** UI thread gọi khi nhận một frame message - cho phép phát frame kế */
+    void AcknowledgeFrame() { framePending_.store(false, std::memory_order_release); }
+
+    bool IsRunning() const { return running_.load(std::memory_order_relaxed); }
+
+private:
+    void PumpLoop();
+
+    HWND hwnd_;
+    UINT frameMsg_;
+    std::thread pump_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> framePending_{false};
+};
@@ -1,6 +1,7 @@
 #include <windows.h>
 #include "MainWindow.h"
 #include "UiConstants.h"
+#include "../core/TaskScheduler.h"
 #include <sstream>
 #include <commctrl.h>
 #include <uxtheme.h>
@@ -226,6 +227,48 @@ LRESULT MainWindow::HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam) {
         case WM_COMMAND:
             OnCommand(wParam);
             return 0;
+
+        case UiConstants::Messages::SEND_COMPLETE:
+            // Async send hoàn tất trên worker thread (xem HttpClient::sendMessageAsync)
+            OnSendMessageComplete(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::STREAM_DELTA:
+            OnStreamDelta(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::STREAM_DONE:
+            OnStreamComplete(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::HEALTH_RESULT:
+            // Health probe hoàn tất trên worker thread (xem HttpClient::checkHealthAsync)
+            OnHealthCheckComplete(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::CONVERSATIONS_PAGE:
+            // Một page sidebar về từ worker thread (xem HttpClient::getConversationsAsync)
+            OnConversationsPageResult(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::CONVERSATIONS_CHANGED:
+            // Backend có conversation mới (kênh long-poll, xem UpdateChannel)
+            // -> delta refresh chỉ fetch phần đầu mới hơn newestConversationId_
+            RefreshConversations();
+            return 0;
+
+        case UiConstants::Messages::CONVERSATION_PREFETCH:
+            // Transcript prefetch về từ worker thread (xem StartHoverPrefetch)
+            OnConversationPrefetchResult(wParam, (std::string*)lParam);
+            return 0;
+
+        case UiConstants::Messages::ANIM_FRAME:
+            // Frame 60Hz từ AnimationDriver; ack trước để pump phát frame kế
+            if (animDriver_) {
+                animDriver_->AcknowledgeFrame();
+            }
+            OnAnimationFrame(wParam);
+            return 0;
             
         case WM_KEYDOWN:
             HandleKeyDown(wParam);
@@ -309,6 +352,16 @@ LRESULT MainWindow::HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam) {
             return 0;
             
         case WM_DESTROY:
+            // Dừng kênh long-poll trước khi window chết (destructor join
+            // thread poll để nó không post về window đã hủy)
+            updateChannel_.reset();
+            // Hạ worker pool TRƯỚC khi MainWindow (và httpClient_ member)
+            // rời stack của WinMain: task đang chạy dở capture HttpClient*,
+            // để singleton tự join lúc static destruction là quá muộn.
+            // Abort trước để task đang kẹt trong WinInet fail ngay thay vì
+            // chờ timeout 30s.
+            httpClient_.abortPendingRequests();
+            TaskScheduler::GetInstance().Shutdown();
             HideMessageTooltip();
             if (copyFeedbackTimerId_ != 0) {
                 KillTimer(hwnd_, copyFeedbackTimerId_);
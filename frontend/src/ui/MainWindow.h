@@ -8,12 +8,20 @@
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <map>
+#include <algorithm> // std::upper_bound (ChatViewState::FirstVisibleMessage)
 #include "HttpClient.h"
 #include "UiStrings.h"
 #include "GDIResourceManager.h"
 #include "UiConstants.h"
 #include "UiConfig.h"
 #include "../core/ExportService.h"
+#include "../core/SearchIndex.h"
+#include "../core/SessionPrefetchCache.h"
+#include "../core/UpdateChannel.h"
+#include "../core/MetadataBlobStore.h"
+#include "RenderBackend.h"
+#include "AnimationDriver.h"
 
 enum class MessageType {
     User,
@@ -25,11 +33,13 @@ enum class MessageType {
 };
 
 struct MessageMetadata {
-    std::string rawJson;           // Raw JSON response from backend (if available)
+    // Body response gốc không còn giữ plain text ở đây - nén trong
+    // MetadataBlobStore, rehydrate on demand khi tooltip cần (0 = không có)
+    MetadataBlobStore::BlobId rawJsonBlob = 0;
     int tokenUsage = 0;            // Token count used for this message
     int latencyMs = 0;              // Response latency in milliseconds
     std::wstring modelName;         // Model name used (if available)
-    
+
     MessageMetadata() {}
 };
 
@@ -43,23 +53,74 @@ struct ChatMessage {
     ChatMessage() : isUser(false), type(MessageType::AI) {}
 };
 
+// Cached layout của một message bubble (kết quả DT_CALCRECT).
+// Hợp lệ khi measuredForWidth trùng maxBubbleWidth hiện tại và measuredTextLength
+// trùng độ dài text — tự vô hiệu khi window resize hoặc text bị sửa (vd streaming
+// append), không cần hook mọi chỗ mutate message.
+struct MessageLayout {
+    int textWidth = 0;
+    int textHeight = 0;
+    int bubbleWidth = 0;
+    int bubbleHeight = 0;
+    int measuredForWidth = -1;      // maxBubbleWidth lúc đo; -1 = chưa đo
+    size_t measuredTextLength = 0;  // msg.text.length() lúc đo
+};
+
 // State management for chat view UI
 struct ChatViewState {
     std::vector<ChatMessage> messages;
+    // Song song với messages; được resize/đo lazy trong EnsureMessageLayout.
+    // Tránh chạy DT_CALCRECT trên toàn bộ transcript mỗi WM_PAINT.
+    std::vector<MessageLayout> layouts;
+    // Prefix-sum của chiều cao bubble: heightPrefix[i] = tổng
+    // (bubbleHeight + messageMarginY) của messages [0, i). Size = messages.size() + 1.
+    // Được rebuild trong DrawChatMessages; cho phép tìm message đầu tiên
+    // trong viewport bằng binary search thay vì duyệt tuần tự.
+    std::vector<int> heightPrefix;
     int scrollOffset = 0;           // For scrolling chat messages (pixels)
     bool autoScrollToBottom = true;  // When true, always keep view pinned to latest message
     bool showPlaceholder = true;     // Show placeholder text in input field
     
-    // Input animation state (center -> bottom)
+    // Input animation state (center -> bottom). Nội suy theo thời gian thực
+    // (animElapsedMs cộng dồn delta từ AnimationDriver) thay vì đếm tick
     bool isAnimating = false;
     int animCurrentY = 0;
     int animTargetY = 0;
     int animStartY = 0;
-    UINT_PTR animTimerId_ = 0;  // Note: underscore suffix to match existing code style
+    double animElapsedMs = 0.0;
     
+    // Tổng chiều cao nội dung chat (0 nếu chưa paint lần nào)
+    int TotalMessagesHeight() const {
+        return heightPrefix.empty() ? 0 : heightPrefix.back();
+    }
+
+    // Y (tương đối so với đầu nội dung) của message index; O(1) nhờ prefix-sum
+    int MessageTop(size_t index) const {
+        return (index < heightPrefix.size()) ? heightPrefix[index] : 0;
+    }
+
+    // Index của message đầu tiên còn giao với viewport bắt đầu từ contentY
+    // (pixel tính từ đầu nội dung). O(log n) — binary search trên prefix-sum.
+    size_t FirstVisibleMessage(int contentY) const {
+        if (heightPrefix.size() < 2) return 0;
+        auto it = std::upper_bound(heightPrefix.begin(), heightPrefix.end() - 1, contentY);
+        if (it == heightPrefix.begin()) return 0;
+        return static_cast<size_t>((it - heightPrefix.begin()) - 1);
+    }
+
+    // Đánh dấu layout của một message cần đo lại (khi text bị ghi đè
+    // mà độ dài tình cờ không đổi thì heuristic length không bắt được)
+    void InvalidateLayout(size_t index) {
+        if (index < layouts.size()) {
+            layouts[index].measuredForWidth = -1;
+        }
+    }
+
     // Reset all state to initial values
     void Reset() {
         messages.clear();
+        layouts.clear();
+        heightPrefix.clear();
         scrollOffset = 0;
         autoScrollToBottom = true;
         showPlaceholder = true;
@@ -67,19 +128,23 @@ struct ChatViewState {
         animCurrentY = 0;
         animTargetY = 0;
         animStartY = 0;
-        if (animTimerId_ != 0) {
-            // Note: Need HWND to kill timer, so this is handled externally
-            animTimerId_ = 0;
-        }
+        animElapsedMs = 0.0;
+        // Note: AnimationDriver được stop bên ngoài (cần MainWindow)
     }
 };
 
 struct ConversationInfo {
     int id;
     std::wstring sessionId;
-    std::wstring preview; // First few words of user_message
-    std::wstring timestamp; // Formatted created_at
+    // preview/timestamp format lazy từ rawUserMessage/rawCreatedAt khi row
+    // lần đầu scroll vào vùng nhìn thấy (EnsureConversationDisplay) - archive
+    // 10k session không trả chi phí convert/format cho item chưa từng hiện
+    std::wstring preview; // First few words of user_message (rỗng tới khi displayReady)
+    std::wstring timestamp; // Formatted created_at (rỗng tới khi displayReady)
     std::string rawSessionId; // UTF-8 session_id for API calls
+    std::string rawUserMessage; // user_message UTF-8 (nguồn của preview)
+    std::string rawCreatedAt; // created_at UTF-8 (nguồn của timestamp)
+    bool displayReady = false; // preview/timestamp đã format chưa
 };
 
 // Nhóm hằng số theme/layout để dễ quản lý
@@ -131,25 +196,62 @@ private:
     void HandleSidebarMouseWheel(WPARAM wParam);
     void HandleChatMouseWheel(WPARAM wParam);
     void HandleTimer(WPARAM wParam);
+    // Một frame từ AnimationDriver (dtMicros = delta time microseconds)
+    void OnAnimationFrame(WPARAM dtMicros);
+    // Khởi động animation input (tạo driver lazy, reset elapsed time)
+    void StartInputAnimation();
     void HandleKeyDown(WPARAM wParam);
     void HandleLeftButtonDown(LPARAM lParam);
     void HandleMouseMove(LPARAM lParam);
     void HandleMouseLeave();
     
     void SendChatMessage();
+    void OnSendMessageComplete(WPARAM requestId, std::string* responsePtr);
+    void OnStreamDelta(WPARAM requestId, std::string* deltaPtr);
+    void OnStreamComplete(WPARAM requestId, std::string* errorPtr);
+    // Layer tĩnh vẽ sẵn (grid nền + orb): render một lần, mỗi frame chỉ còn
+    // một BitBlt / AlphaBlend thay vì hàng trăm LineTo + bitmap tạm
+    void EnsureStaticLayers(HDC hdcWindow, const RECT& clientRect);
     void DrawInputField(HDC hdc);
     void DrawSendButton(HDC hdc, const RECT& rc);
     void DrawNewSessionButton(HDC hdc, const RECT& rc, bool isPressed);
     void DrawChatMessages(HDC hdc);
+    // Trả về layout đã cache cho message msgIdx, đo lại (DT_CALCRECT) khi cần
+    const MessageLayout& EnsureMessageLayout(HDC hdc, size_t msgIdx, int maxBubbleWidth);
     void DrawSidebar(HDC hdc);
     void DrawStatusBadge(HDC hdc, const RECT& headerRect, RECT* outBadgeRect = nullptr, int titleEndX = 0);
+    // Debug HUD: bảng PerfMetrics vẽ đè lên frame (toggle Ctrl+Shift+P)
+    void DrawPerfHud(HDC hdc);
     void RefreshConversations();
+    // Async refresh pipeline (xem RefreshConversations): từng page post về
+    // qua CONVERSATIONS_PAGE, merge trên UI thread rồi fetch page kế tiếp
+    void OnConversationsPageResult(WPARAM requestId, std::string* jsonPtr);
+    bool MergeConversationsPage(const std::string& json, bool& outPageOk);
+    void FinishConversationsRefresh(bool sweepComplete);
+    // Format preview/timestamp lần đầu item hiện trong sidebar (lazy)
+    static void EnsureConversationDisplay(ConversationInfo& info);
     void LoadConversationBySessionId(const std::string& sessionId);
+    // Parse transcript JSON rồi thay toàn bộ chat view. false nếu JSON
+    // không parse được hoặc không có conversation nào
+    bool ApplyConversationTranscript(const std::string& sessionId, const std::string& json);
+    // Speculative prefetch khi hover sidebar: timer một nhịp
+    // (HOVER_PREFETCH_DELAY_MS) -> fetch lane Prefetch -> cache LRU,
+    // click sau đó render thẳng từ cache không cần round-trip
+    void ScheduleHoverPrefetch();
+    void StartHoverPrefetch();
+    void OnConversationPrefetchResult(WPARAM requestId, std::string* jsonPtr);
+    // On-disk cache (ConversationCache): UI vẽ dữ liệu lần trước ngay khi
+    // khởi động, backend reconcile sau qua delta refresh
+    void LoadConversationCache();
+    void SaveConversationCache();
     void RefreshTasks();
     void CreateTask();
     
     void AppendTextToEdit(HWND hEdit, const std::wstring& text);
     void ClearEdit(HWND hEdit);
+
+    // Đổi session qua đây để sessionIdW_ (bản wide cache) luôn khớp
+    void SetSessionId(const std::string& sessionId);
     
     // Helper functions for creating messages
     ChatMessage CreateUserMessage(const std::wstring& text);
@@ -195,6 +297,25 @@ private:
     GDIFontPtr hSidebarItemFont_;
     GDIFontPtr hSidebarMetaFont_;
     
+    // Pre-rendered static layers (see EnsureStaticLayers).
+    // gridLayer_ phủ cả client area nên reset khi WM_SIZE; orbLayer_ cố định.
+    GDILayerPtr gridLayer_;
+    GDILayerPtr orbLayer_;
+
+    // Backbuffer + present đi qua RenderBackend (GDI mặc định, Direct2D
+    // opt-in qua config "renderBackend"); tạo lazy ở OnPaint vì cần hwnd_
+    std::unique_ptr<RenderBackend> renderBackend_;
+    std::string renderBackendName_ = "gdi";
+
+    // Frame pump 60Hz cho animation (thay SetTimer 15ms); tạo lazy khi
+    // animation đầu tiên chạy, Start/Stop theo isAnimating
+    std::unique_ptr<AnimationDriver> animDriver_;
+
+    // Kênh long-poll báo conversation mới từ backend (tạo trong OnCreate,
+    // hủy trong WM_DESTROY trước khi window chết); thay cho mọi nhu cầu
+    // poll lại danh sách định kỳ
+    std::unique_ptr<UpdateChannel> updateChannel_;
+
     // Window dimensions
     int windowWidth_;
     int windowHeight_;
@@ -204,6 +325,10 @@ private:
     
     HttpClient httpClient_;
     std::string sessionId_;
+    // Bản wide cache của sessionId_, convert một lần khi session đổi.
+    // OnPaint vẽ session id mỗi frame — không gọi MultiByteToWideChar trong paint.
+    std::wstring sessionIdW_;
+    UINT_PTR sendRequestId_ = 0; // Tăng dần; dùng để bỏ qua async response cũ
     std::string configPath_;   // Path to config file
     std::wstring modelName_;   // Current model name from backend health
     
@@ -220,6 +345,11 @@ private:
     
     // Sidebar conversations list
     std::vector<ConversationInfo> conversations_;
+    // Cache theo rawSessionId, giữ qua các lần refresh. RefreshConversations chỉ
+    // fetch các conversation mới hơn newestConversationId_ và merge vào đây,
+    // thay vì tải lại toàn bộ lịch sử sau mỗi lần gửi.
+    std::map<std::string, ConversationInfo> conversationCache_;
+    int newestConversationId_ = 0; // Id lớn nhất đã thấy từ backend
     int sidebarWidth_ = 280;     // Width of sidebar panel
     int sidebarScrollOffset_ = 0; // Scroll offset for sidebar
     int selectedConversationIndex_ = -1; // Currently selected conversation
@@ -228,6 +358,7 @@ private:
     bool isSendButtonHover_ = false;
     bool isNewSessionButtonHover_ = false;
     bool sidebarVisible_ = true; // Toggle sidebar visibility
+    bool perfHudVisible_ = false; // Debug HUD (PerfMetrics) - Ctrl+Shift+P
     
     // Health check state
     enum class HealthStatus {
@@ -237,7 +368,21 @@ private:
     };
     HealthStatus healthStatus_ = HealthStatus::Checking;
     UINT_PTR healthCheckTimerId_ = 0;
+    UINT_PTR healthRequestId_ = 0;     // Bỏ qua kết quả health check cũ
+    UINT healthOfflineBackoffMs_ = 0;  // Interval hiện tại khi Offline (x2 mỗi lần fail)
+
+    // Async conversations refresh state (RefreshConversations / OnConversationsPageResult)
+    UINT_PTR conversationsRequestId_ = 0;    // Bỏ qua page result của lượt cũ
+    bool conversationsFetchActive_ = false;  // Đang có lượt refresh chạy
+    bool conversationsRefreshQueued_ = false; // Refresh được yêu cầu giữa chừng
+    bool conversationsInitialLoad_ = false;  // Cache rỗng lúc bắt đầu lượt này
+    int conversationsFetchSkip_ = 0;         // skip của page đang bay
+    int conversationsHighestSeenId_ = 0;     // Max id thấy được trong lượt này
+    ULONGLONG conversationsFetchStartTick_ = 0; // Đo conversations.refresh (PerfMetrics)
+    // Probe chạy async trên worker thread; kết quả về qua HEALTH_RESULT và
+    // OnHealthCheckComplete đặt lịch poll kế tiếp theo trạng thái (adaptive backoff)
     void CheckHealthStatus();
+    void OnHealthCheckComplete(WPARAM requestId, std::string* responsePtr);
     
     // Settings icon state
     bool isSettingsIconHover_ = false;
@@ -251,7 +396,10 @@ private:
     void ShowExportDialog();
     static LRESULT CALLBACK ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
     bool ExportCurrentConversation(const std::wstring& filePath, ExportFormat format);
-    bool ExportAllConversations(const std::wstring& filePath, ExportFormat format);
+    // Blocking (fetch + convert + ghi file) - export dialog chạy nó trên
+    // thread riêng và nhận tiến độ qua progress (xem ExportDlgProc)
+    bool ExportAllConversations(const std::wstring& filePath, ExportFormat format,
+                                const ExportService::ProgressCallback& progress = {});
     void ShowExportMessageDialog(const std::wstring& message, bool isSuccess);
     static LRESULT CALLBACK ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
     
@@ -264,6 +412,21 @@ private:
     void SaveSettingsToFile(const std::string& baseUrl, const std::string& apiKey, bool ctrlEnterEnabled = true);
     void UpdateModelNameFromHealth(const std::string& healthJson);
     
+    // Thông số ngang của lần DrawChatMessages gần nhất. Cùng với layout
+    // cache (layouts + heightPrefix) là đủ để suy ra bubble rect của bất
+    // kỳ message nào mà không đụng GDI - hit-test hover/click đi qua đây
+    // thay vì đo lại text (xem GetMessageBubbleRect/UpdateMessageHover).
+    struct ChatHitTestGeometry {
+        bool valid = false;            // false tới lần paint đầu tiên
+        int messageAreaTop = 0;
+        int messageAreaLeft = 0;
+        int messageAreaRight = 0;
+        int aiMessageMarginLeft = 0;
+        int userMessageMarginRight = 0;
+        int bubbleOffsetX = 0;         // avatar + margin (bubble AI thụt vào)
+    };
+    ChatHitTestGeometry chatHitGeometry_;
+
     // Hover tracking for messages
     int hoveredMessageIndex_ = -1; // Index of hovered message bubble
     void UpdateMessageHover(int x, int y);
@@ -274,6 +437,12 @@ private:
     UINT_PTR copyFeedbackTimerId_ = 0; // Timer to reset checkmark back to copy icon
     RECT GetMessageBubbleRect(int messageIndex); // Get bubble rect for a message
     RECT GetCopyIconRect(int messageIndex); // Get copy icon rect for a message
+    // Dirty-region invalidation: hover/feedback chỉ invalidate đúng rect của
+    // element bị đổi, OnPaint clip theo ps.rcPaint -> mouse move tốn một blit
+    // cỡ cái nút thay vì composite lại cả frame
+    RECT GetSidebarItemRect(int index);     // Row rect trong sidebar (window coords)
+    void InvalidateSidebarItem(int index);  // No-op nếu index/rect không hợp lệ
+    void InvalidateMessageHover(int messageIndex); // Bubble + copy icon của một message
     void CopyMessageToClipboard(int messageIndex); // Copy message text to clipboard
     
     // Tooltip support
@@ -284,6 +453,10 @@ private:
     
     // Settings: Ctrl+Enter to send
     bool enableCtrlEnterToSend_ = true; // Default enabled
+
+    // Settings: streaming response mode (token-by-token qua /api/llm/stream).
+    // Mặc định tắt vì endpoint streaming hiện chưa lưu conversation vào DB.
+    bool enableStreamingResponses_ = false;
     
     // Double-click tracking
     DWORD lastClickTime_ = 0;
@@ -291,11 +464,22 @@ private:
 
     // Hover tracking for sidebar items
     int hoveredConversationIndex_ = -1;
+
+    // Blob store nén cho body response gốc của từng message (xem
+    // MessageMetadata.rawJsonBlob); Clear khi transcript bị thay
+    MetadataBlobStore metadataBlobs_;
+
+    // Transcript prefetch (xem ScheduleHoverPrefetch)
+    SessionPrefetchCache transcriptPrefetchCache_;
+    UINT_PTR prefetchRequestId_ = 0;          // Staleness check cho kết quả prefetch
+    std::string prefetchInFlightSession_;     // Session đang prefetch (tránh bắn trùng)
     
     // Search functionality
     bool searchVisible_ = false;              // Whether search bar is visible
     HWND hSearchEdit_ = NULL;                 // Search input edit control
     std::wstring searchQuery_;                 // Current search query
+    std::wstring searchQueryFolded_;           // Query đã case-fold (fold một lần mỗi keystroke)
+    SearchIndex searchIndex_;                  // Folded text + trigram index cho messages
     std::vector<int> searchResults_;           // Indices of messages containing search query
     int currentSearchIndex_ = -1;              // Current highlighted search result index
     RECT searchBarRect_;                      // Search bar rectangle for rendering
@@ -312,6 +496,6 @@ private:
     void ScrollToSearchResult(int messageIndex);
     void DrawSearchBar(HDC hdc);
     void DrawSearchButton(HDC hdc, const RECT& rect, const wchar_t* text, bool isHovered);
-    void DrawSearchHighlight(HDC hdc, const std::wstring& text, const RECT& textRect, HFONT hFont);
-    std::vector<std::pair<size_t, size_t>> FindTextMatches(const std::wstring& text, const std::wstring& query);
+    void DrawSearchHighlight(HDC hdc, size_t msgIdx, const std::wstring& text,
+                             const RECT& textRect, HFONT hFont);
 };
\ No newline at end of file
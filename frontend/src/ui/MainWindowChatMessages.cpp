@@ -1,11 +1,57 @@
 #include <windows.h>
 #include "MainWindow.h"
+#include "../core/PerfMetrics.h"
 #include <string>
 #include <algorithm>
 
 // UI layout & chat rendering (render primitives are defined in MainWindowRender.cpp)
 
+const MessageLayout& MainWindow::EnsureMessageLayout(HDC hdc, size_t msgIdx, int maxBubbleWidth) {
+    // Vector layouts chạy song song với messages; sync size lazy ở đây
+    // nên các chỗ thêm/xóa message không cần quan tâm tới cache.
+    auto& layouts = chatViewState_.layouts;
+    if (layouts.size() != chatViewState_.messages.size()) {
+        layouts.resize(chatViewState_.messages.size());
+    }
+
+    const ChatMessage& msg = chatViewState_.messages[msgIdx];
+    MessageLayout& layout = layouts[msgIdx];
+    if (layout.measuredForWidth == maxBubbleWidth &&
+        layout.measuredTextLength == msg.text.length()) {
+        return layout; // Cache hit: không cần DT_CALCRECT
+    }
+
+    // Code bubbles dùng padding lớn hơn (dễ đọc hơn) — phải tính ở đây
+    // để bubbleHeight trong pass tổng chiều cao khớp với lúc vẽ thật.
+    bool isCodeBubble = (msg.type == MessageType::Code);
+    int bubblePaddingX = isCodeBubble ? 24 : 16;
+    int bubblePaddingY = isCodeBubble ? 18 : 12;
+
+    HFONT hCurrentFont;
+    if (isCodeBubble) {
+        hCurrentFont = hCodeFont_->Get();
+    } else if (msg.type == MessageType::User) {
+        hCurrentFont = hMessageFont_->Get();
+    } else {
+        hCurrentFont = hAIMessageFont_->Get();
+    }
+    // Đo qua cache memo của GDIResourceManager: resize về width cũ hoặc mở lại
+    // conversation cũ không phải chạy lại DT_CALCRECT cho text đã đo
+    SIZE textSize = gdiManager_->MeasureText(hdc, hCurrentFont, msg.text,
+                                             maxBubbleWidth - 2 * bubblePaddingX,
+                                             DT_LEFT | DT_WORDBREAK);
+
+    layout.textWidth = textSize.cx;
+    layout.textHeight = textSize.cy;
+    layout.bubbleWidth = layout.textWidth + 2 * bubblePaddingX;
+    layout.bubbleHeight = layout.textHeight + 2 * bubblePaddingY + 16; // +16 for timestamp row
+    layout.measuredForWidth = maxBubbleWidth;
+    layout.measuredTextLength = msg.text.length();
+    return layout;
+}
+
 void MainWindow::DrawChatMessages(HDC hdc) {
+    PerfMetrics::ScopedTimer timer("paint.chatMessages");
     RECT clientRect;
     GetClientRect(hwnd_, &clientRect);
     
@@ -44,31 +90,28 @@ void MainWindow::DrawChatMessages(HDC hdc) {
     
     SetBkMode(hdc, TRANSPARENT);
     
-    // Calculate total height needed for all messages
-    int totalHeight = 0;
-    for (const auto& msg : chatViewState_.messages) {
-        // Ensure we measure text with the correct font for each message type
-        HFONT hCurrentFont = hMessageFont_->Get();
-        if (msg.type == MessageType::Code) {
-            hCurrentFont = hCodeFont_->Get();
-        } else if (msg.type == MessageType::User) {
-            hCurrentFont = hMessageFont_->Get();
-        } else {
-            hCurrentFont = hAIMessageFont_->Get();
-        }
-        SelectObject(hdc, hCurrentFont);
-
-        RECT textRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-        DrawTextW(hdc, msg.text.c_str(), -1, &textRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
+    // Rebuild prefix-sum chiều cao bubble. Layout từng message được cache
+    // (EnsureMessageLayout) nên pass này chỉ tốn DT_CALCRECT cho các entry
+    // dirty (resize / message mới / text đổi); phần còn lại chỉ là cộng int.
+    auto& heightPrefix = chatViewState_.heightPrefix;
+    heightPrefix.resize(chatViewState_.messages.size() + 1);
+    heightPrefix[0] = 0;
+    for (size_t msgIdx = 0; msgIdx < chatViewState_.messages.size(); msgIdx++) {
+        heightPrefix[msgIdx + 1] = heightPrefix[msgIdx] +
+            EnsureMessageLayout(hdc, msgIdx, maxBubbleWidth).bubbleHeight + messageMarginY;
+    }
+    int totalHeight = heightPrefix.back();
 
-        // Use the same bubble height formula as when drawing,
-        // so that the last message never hides behind the input field.
-        int textHeight = textRect.bottom;
-        int bubbleHeight = textHeight + 2 * bubblePaddingY + 16; // +16 for timestamp row
+    // Layout giờ đã fresh - lưu hình học ngang cho hit-test. Hover/click
+    // từ đây tới lần paint sau tính rect từ cache này, zero GDI.
+    chatHitGeometry_.valid = true;
+    chatHitGeometry_.messageAreaTop = messageAreaTop;
+    chatHitGeometry_.messageAreaLeft = messageAreaLeft;
+    chatHitGeometry_.messageAreaRight = messageAreaRight;
+    chatHitGeometry_.aiMessageMarginLeft = aiMessageMarginLeft;
+    chatHitGeometry_.userMessageMarginRight = userMessageMarginRight;
+    chatHitGeometry_.bubbleOffsetX = 20 + 8; // avatarSize + avatarMargin (khớp vòng vẽ bên dưới)
 
-        totalHeight += bubbleHeight + messageMarginY;
-    }
-    
     // Compute scrolling bounds
     int availableHeight = messageAreaBottom - messageAreaTop;
     int maxScroll = 0;
@@ -84,31 +127,20 @@ void MainWindow::DrawChatMessages(HDC hdc) {
         if (chatViewState_.scrollOffset < 0) chatViewState_.scrollOffset = 0;
     }
     
-    int currentY = messageAreaTop - chatViewState_.scrollOffset;
-    
+    // Virtualized rendering: binary search message đầu tiên trong viewport
+    // rồi chỉ vẽ cho tới khi ra khỏi đáy — messages ngoài màn hình không
+    // được duyệt tới (transcript dài không còn là O(n) mỗi frame).
+    size_t firstVisible = chatViewState_.FirstVisibleMessage(chatViewState_.scrollOffset);
+    int currentY = messageAreaTop - chatViewState_.scrollOffset + heightPrefix[firstVisible];
+
     // Draw messages from oldest to newest
-    for (size_t msgIdx = 0; msgIdx < chatViewState_.messages.size(); msgIdx++) {
+    for (size_t msgIdx = firstVisible; msgIdx < chatViewState_.messages.size(); msgIdx++) {
         const auto& msg = chatViewState_.messages[msgIdx];
+        const MessageLayout& layout = EnsureMessageLayout(hdc, msgIdx, maxBubbleWidth);
+
         if (currentY > messageAreaBottom) break; // Skip messages below visible area
-        if (currentY + 50 < messageAreaTop) { // Skip messages above visible area
-            // Estimate height and continue
-            HFONT hCurrentFont = hMessageFont_->Get();
-            if (msg.type == MessageType::Code) {
-                hCurrentFont = hCodeFont_->Get();
-            } else if (msg.type == MessageType::User) {
-                hCurrentFont = hMessageFont_->Get();
-            } else {
-                hCurrentFont = hAIMessageFont_->Get();
-            }
-            SelectObject(hdc, hCurrentFont);
 
-            RECT testRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-            DrawTextW(hdc, msg.text.c_str(), -1, &testRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
-            currentY += testRect.bottom + 2 * bubblePaddingY + messageMarginY;
-            continue;
-        }
-        
-        // Select correct font for this message and calculate text size
+        // Select correct font for this message (kích thước lấy từ layout cache)
         HFONT hCurrentFont = hMessageFont_->Get();
         if (msg.type == MessageType::Code) {
             hCurrentFont = hCodeFont_->Get();
@@ -119,13 +151,11 @@ void MainWindow::DrawChatMessages(HDC hdc) {
         }
         SelectObject(hdc, hCurrentFont);
 
-        RECT textRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-        DrawTextW(hdc, msg.text.c_str(), -1, &textRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
-        int textWidth = textRect.right;
-        int textHeight = textRect.bottom;
-        
-        int bubbleWidth = textWidth + 2 * bubblePaddingX;
-        int bubbleHeight = textHeight + 2 * bubblePaddingY + 16; // space for timestamp
+        int textWidth = layout.textWidth;
+        int textHeight = layout.textHeight;
+
+        int bubbleWidth = layout.bubbleWidth;
+        int bubbleHeight = layout.bubbleHeight;
         
         RECT bubbleRect;
         RECT textDrawRect;
@@ -210,7 +240,7 @@ void MainWindow::DrawChatMessages(HDC hdc) {
             
             // Draw search highlights first (behind text)
             if (searchVisible_ && !searchQuery_.empty()) {
-                DrawSearchHighlight(hdc, msg.text, textDrawRect, hMessageFont_->Get());
+                DrawSearchHighlight(hdc, msgIdx, msg.text, textDrawRect, hMessageFont_->Get());
             }
             
             DrawTextW(hdc, msg.text.c_str(), -1, &textDrawRect, DT_LEFT | DT_WORDBREAK);
@@ -260,13 +290,7 @@ void MainWindow::DrawChatMessages(HDC hdc) {
             DeleteObject(avatarPen);
         } else {
             // AI / system message: left-aligned bubble
-            SelectObject(hdc, hAIMessageFont_->Get());
-            RECT aiTextRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-            DrawTextW(hdc, msg.text.c_str(), -1, &aiTextRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
-            textWidth = aiTextRect.right;
-            textHeight = aiTextRect.bottom;
-            bubbleWidth = textWidth + 2 * bubblePaddingX;
-            bubbleHeight = textHeight + 2 * bubblePaddingY + 16;
+            // (kích thước đã nằm trong layout cache, kể cả padding riêng của code)
 
             // Determine bubble style based on message type
             MessageType msgType = msg.type;
@@ -283,10 +307,6 @@ void MainWindow::DrawChatMessages(HDC hdc) {
             // Code bubbles use different padding (more padding for better readability)
             int codePaddingX = isCodeBubble ? 24 : bubblePaddingX;
             int codePaddingY = isCodeBubble ? 18 : bubblePaddingY;
-            if (isCodeBubble) {
-                bubbleWidth = textWidth + 2 * codePaddingX;
-                bubbleHeight = textHeight + 2 * codePaddingY + 16;
-            }
             
             bubbleRect.left = messageAreaLeft + aiMessageMarginLeft + bubbleOffsetX;
             bubbleRect.right = bubbleRect.left + bubbleWidth;
@@ -440,7 +460,7 @@ void MainWindow::DrawChatMessages(HDC hdc) {
             // Draw search highlights first (behind text)
             if (searchVisible_ && !searchQuery_.empty()) {
                 HFONT highlightFont = isCodeBubble ? hCodeFont_->Get() : hAIMessageFont_->Get();
-                DrawSearchHighlight(hdc, msg.text, textDrawRect, highlightFont);
+                DrawSearchHighlight(hdc, msgIdx, msg.text, textDrawRect, highlightFont);
             }
             
             DrawTextW(hdc, msg.text.c_str(), -1, &textDrawRect, DT_LEFT | DT_WORDBREAK);
@@ -3,6 +3,8 @@
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
 #include "JsonParser.h"
+#include "ConversationCache.h"
+#include "PerfMetrics.h"
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
@@ -13,96 +15,203 @@
 // Conversation/task refresh and hover utilities split from MainWindowLogic.cpp
 
 void MainWindow::RefreshConversations() {
-    std::string conversationsJson = httpClient_.getConversations(""); // Get all conversations
-    conversations_.clear();
-    
-    // Check for errors
-    if (conversationsJson.empty() || conversationsJson.find("Error:") == 0) {
-        return; // Error or empty
+    using namespace UiConstants;
+
+    // Fetch theo page (backend trả newest-first) và merge delta vào
+    // conversationCache_. Lần đầu tải hết; các lần sau dừng ngay khi gặp
+    // id đã thấy (newestConversationId_) — refresh sau mỗi lần gửi chỉ
+    // tốn một request nhỏ thay vì tải lại toàn bộ lịch sử.
+    //
+    // Các page đi qua getConversationsAsync: request bay trên worker thread,
+    // kết quả post về CONVERSATIONS_PAGE và merge ở OnConversationsPageResult.
+    // Startup vì thế chạy song song với health check thay vì xếp hàng sau nó,
+    // và UI không bao giờ block trên round-trip nào.
+    if (conversationsFetchActive_) {
+        conversationsRefreshQueued_ = true; // Chạy lại ngay khi lượt này xong
+        return;
     }
-    
-    // Parse JSON array using JsonParser
-    std::vector<nlohmann::json> conversationsArray = JsonParser::ParseArray(conversationsJson);
-    if (conversationsArray.empty()) {
-        return; // Failed to parse or empty array
+
+    conversationsFetchActive_ = true;
+    conversationsRefreshQueued_ = false;
+    conversationsInitialLoad_ = conversationCache_.empty();
+    conversationsFetchSkip_ = 0;
+    conversationsHighestSeenId_ = newestConversationId_;
+    conversationsFetchStartTick_ = GetTickCount64();
+
+    conversationsRequestId_++;
+    httpClient_.getConversationsAsync("", 0, Sidebar::REFRESH_PAGE_SIZE, hwnd_,
+                                      Messages::CONVERSATIONS_PAGE, conversationsRequestId_);
+}
+
+void MainWindow::OnConversationsPageResult(WPARAM requestId, std::string* jsonPtr) {
+    using namespace UiConstants;
+    std::unique_ptr<std::string> json(jsonPtr); // Ownership chuyển qua PostMessage
+
+    // Page của lượt refresh đã bị thay thế (session mới giữa chừng)
+    if (requestId != conversationsRequestId_ || !conversationsFetchActive_) {
+        return;
     }
-    
-    // Group conversations by session_id
-    std::map<std::string, ConversationInfo> sessionMap;
-    
-    try {
-        for (const auto& conv : conversationsArray) {
-            if (!conv.is_object()) {
-                continue;
-            }
-            
-            // Extract fields using nlohmann/json
-            std::string sessionId;
-            int id = 0;
-            std::string userMessage;
-            std::string createdAt;
-            
-            if (conv.contains("session_id") && conv["session_id"].is_string()) {
-                sessionId = conv["session_id"].get<std::string>();
-            }
-            
-            if (conv.contains("id") && conv["id"].is_number_integer()) {
-                id = conv["id"].get<int>();
-            } else if (conv.contains("id") && conv["id"].is_number_unsigned()) {
-                id = static_cast<int>(conv["id"].get<unsigned int>());
-            }
-            
-            if (conv.contains("user_message") && conv["user_message"].is_string()) {
-                userMessage = conv["user_message"].get<std::string>();
-            }
-            
-            if (conv.contains("created_at") && conv["created_at"].is_string()) {
-                createdAt = conv["created_at"].get<std::string>();
-            }
-            
-            if (sessionId.empty()) {
-                continue; // Skip conversations without session_id
-            }
-            
-            // Create preview from user_message
-            std::wstring preview = UiStrings::Get(IDS_CONVERSATION_PREVIEW_DEFAULT);
-            if (!userMessage.empty()) {
-                preview = Utf8ToWide(userMessage);
-                if (preview.length() > 40) {
-                    preview = preview.substr(0, 37) + L"...";
-                }
-            }
-            
-            // Format timestamp: "2024-01-01T12:00:00" -> "01/01 12:00"
-            std::wstring timestamp = L"";
-            if (!createdAt.empty() && createdAt.length() >= 16) {
-                timestamp = Utf8ToWide(createdAt.substr(5, 5) + " " + createdAt.substr(11, 5));
-            }
-            
-            // Only add if session_id not already in map (keep latest)
-            if (sessionMap.find(sessionId) == sessionMap.end() || sessionMap[sessionId].id < id) {
-                ConversationInfo info;
-                info.id = id;
-                info.sessionId = Utf8ToWide(sessionId);
-                info.preview = preview;
-                info.timestamp = timestamp.empty() ? UiStrings::Get(IDS_CONVERSATION_NEW) : timestamp;
-                info.rawSessionId = sessionId;
-                sessionMap[sessionId] = info;
-            }
+
+    // Lỗi mạng: giữ nguyên cache/danh sách hiện có thay vì xóa trắng sidebar
+    if (!json || json->empty() || json->find("Error:") == 0) {
+        if (conversationsInitialLoad_ && conversationsFetchSkip_ == 0) {
+            conversationsFetchActive_ = false;
+            return; // Chưa merge gì - không có lý do rebuild/save
         }
-    } catch (const std::exception& e) {
-        // Log error and return empty list
-        JsonParser::LogError("Error parsing conversations: " + std::string(e.what()));
+        FinishConversationsRefresh(false); // Đứt giữa chừng - chưa quét hết
         return;
     }
-    
-    // Convert map to vector and sort by id (newest first)
-    for (const auto& pair : sessionMap) {
+
+    bool pageOk = true;
+    if (MergeConversationsPage(*json, pageOk)) {
+        // Còn page: fetch tiếp, vẫn trong cùng lượt refresh
+        conversationsFetchSkip_ += Sidebar::REFRESH_PAGE_SIZE;
+        conversationsRequestId_++;
+        httpClient_.getConversationsAsync("", conversationsFetchSkip_,
+                                          Sidebar::REFRESH_PAGE_SIZE, hwnd_,
+                                          Messages::CONVERSATIONS_PAGE,
+                                          conversationsRequestId_);
+        return;
+    }
+
+    FinishConversationsRefresh(pageOk);
+}
+
+// Merge một page vào conversationCache_. Trả về true nếu cần fetch page kế;
+// outPageOk = false khi page không parse được (lượt quét dừng dang dở).
+bool MainWindow::MergeConversationsPage(const std::string& json, bool& outPageOk) {
+    using namespace UiConstants;
+    const int pageSize = Sidebar::REFRESH_PAGE_SIZE;
+
+    // SAX stream (JsonParser::StreamArray): field đi thẳng từ response
+    // buffer vào ConversationInfo, không dựng DOM trung gian - page 20MB
+    // không còn nhân vài lần trong RAM chỉ để lấy 4 field mỗi element
+    std::string sessionId;
+    int id = 0;
+    std::string userMessage;
+    std::string createdAt;
+    int elementCount = 0;
+    bool deltaStop = false;
+
+    JsonParser::StreamArrayCallbacks cb;
+    cb.onElementStart = [&]() {
+        sessionId.clear();
+        id = 0;
+        userMessage.clear();
+        createdAt.clear();
+    };
+    cb.onString = [&](const std::string& key, const std::string& value) {
+        if (key == "session_id") {
+            sessionId = value;
+        } else if (key == "user_message") {
+            userMessage = value;
+        } else if (key == "created_at") {
+            createdAt = value;
+        }
+    };
+    cb.onInt = [&](const std::string& key, long long value) {
+        if (key == "id") {
+            id = static_cast<int>(value);
+        }
+    };
+    cb.onElementEnd = [&]() -> bool {
+        elementCount++;
+
+        if (id > conversationsHighestSeenId_) {
+            conversationsHighestSeenId_ = id;
+        }
+
+        // Delta refresh: backend trả newest-first, gặp entry đã cache
+        // từ lần trước là có thể dừng toàn bộ (dừng luôn cả parse)
+        if (!conversationsInitialLoad_ && id != 0 && id <= newestConversationId_) {
+            deltaStop = true;
+            return false;
+        }
+
+        if (sessionId.empty()) {
+            return true; // Skip conversations without session_id
+        }
+
+        // Merge: chỉ ghi đè khi entry mới hơn entry đã cache của session này.
+        // Preview/timestamp KHÔNG format ở đây - chỉ giữ chuỗi UTF-8 gốc,
+        // EnsureConversationDisplay format lần đầu row hiện trong sidebar
+        auto cached = conversationCache_.find(sessionId);
+        if (cached == conversationCache_.end() || cached->second.id < id) {
+            ConversationInfo info;
+            info.id = id;
+            info.sessionId = Utf8ToWide(sessionId);
+            info.rawSessionId = sessionId;
+            info.rawUserMessage = std::move(userMessage);
+            info.rawCreatedAt = std::move(createdAt);
+            conversationCache_[sessionId] = std::move(info);
+        }
+        return true;
+    };
+
+    outPageOk = true;
+    if (!JsonParser::StreamArray(json, cb)) {
+        outPageOk = false;
+        return false; // Parse fail - dừng lượt refresh như trước
+    }
+    if (deltaStop || elementCount == 0) {
+        return false; // Đã bắt kịp cache hoặc hết dữ liệu
+    }
+
+    return elementCount >= pageSize;
+}
+
+// Format preview/timestamp từ chuỗi UTF-8 gốc, gọi khi row lần đầu scroll
+// vào vùng nhìn thấy của sidebar. Với archive 10k session, refresh chỉ trả
+// chi phí parse/merge; convert wide + cắt preview dồn về đúng các row hiện.
+void MainWindow::EnsureConversationDisplay(ConversationInfo& info) {
+    if (info.displayReady) {
+        return;
+    }
+
+    // Preview từ user_message
+    info.preview = UiStrings::Get(IDS_CONVERSATION_PREVIEW_DEFAULT);
+    if (!info.rawUserMessage.empty()) {
+        info.preview = Utf8ToWide(info.rawUserMessage);
+        if (info.preview.length() > 40) {
+            info.preview = info.preview.substr(0, 37) + L"...";
+        }
+    }
+
+    // Format timestamp: "2024-01-01T12:00:00" -> "01/01 12:00"
+    info.timestamp = UiStrings::Get(IDS_CONVERSATION_NEW);
+    if (info.rawCreatedAt.length() >= 16) {
+        info.timestamp = Utf8ToWide(info.rawCreatedAt.substr(5, 5) + " " +
+                                    info.rawCreatedAt.substr(11, 5));
+    }
+
+    info.displayReady = true;
+}
+
+void MainWindow::FinishConversationsRefresh(bool sweepComplete) {
+    conversationsFetchActive_ = false;
+
+    // High-water mark chỉ nâng khi lượt quét hoàn tất (deltaStop hoặc hết
+    // dữ liệu). Page giữa chừng fail mà vẫn nâng thì các page cũ chưa kịp
+    // fetch bị delta refresh (id <= newestConversationId_) bỏ qua mãi mãi -
+    // và lỗ hổng đó còn được SaveConversationCache ghi ra disk. Giữ mốc cũ
+    // để lượt refresh kế tiếp quét lại và vá phần còn thiếu.
+    if (sweepComplete) {
+        newestConversationId_ = conversationsHighestSeenId_;
+    }
+
+    // Nâng mốc cho kênh long-poll: thay đổi vừa merge xong không bị báo lại
+    if (updateChannel_) {
+        updateChannel_->NotifySeenId(newestConversationId_);
+    }
+
+    // Rebuild danh sách hiển thị từ cache, sort by id (newest first)
+    conversations_.clear();
+    for (const auto& pair : conversationCache_) {
         conversations_.push_back(pair.second);
     }
-    std::sort(conversations_.begin(), conversations_.end(), 
+    std::sort(conversations_.begin(), conversations_.end(),
               [](const ConversationInfo& a, const ConversationInfo& b) { return a.id > b.id; });
-    
+
     // Update selected index if current session exists
     selectedConversationIndex_ = -1;
     for (size_t i = 0; i < conversations_.size(); i++) {
@@ -111,6 +220,64 @@ void MainWindow::RefreshConversations() {
             break;
         }
     }
+
+    // Snapshot mới nhất ra disk cho lần khởi động sau
+    SaveConversationCache();
+
+    PerfMetrics::GetInstance().Record(
+        "conversations.refresh",
+        (double)(GetTickCount64() - conversationsFetchStartTick_));
+
+    // Sidebar vẽ lại với dữ liệu mới (kết quả về bất đồng bộ)
+    InvalidateRect(hwnd_, NULL, FALSE);
+
+    // Có yêu cầu refresh trong lúc lượt này đang chạy -> chạy lượt mới
+    if (conversationsRefreshQueued_) {
+        RefreshConversations();
+    }
+}
+
+void MainWindow::LoadConversationCache() {
+    std::vector<ConversationInfo> cachedConversations;
+    std::vector<ChatMessage> cachedMessages;
+    std::string lastSessionId;
+    int cachedNewestId = 0;
+
+    if (!ConversationCache::Load(ConversationCache::GetCachePath(configPath_),
+                                 cachedConversations, cachedNewestId,
+                                 lastSessionId, cachedMessages)) {
+        return; // Chưa có cache hoặc file hỏng -> chờ backend như trước
+    }
+
+    // Sidebar hiện ngay với danh sách lần trước; lần RefreshConversations
+    // đầu tiên chạy như delta refresh từ newestConversationId_ thay vì
+    // initial load tải toàn bộ lịch sử
+    conversations_ = std::move(cachedConversations);
+    for (const auto& info : conversations_) {
+        conversationCache_[info.rawSessionId] = info;
+    }
+    newestConversationId_ = cachedNewestId;
+
+    // Khôi phục transcript của session mở gần nhất
+    if (!lastSessionId.empty() && !cachedMessages.empty()) {
+        SetSessionId(lastSessionId);
+        chatViewState_.messages = std::move(cachedMessages);
+        chatViewState_.scrollOffset = 0;
+        chatViewState_.autoScrollToBottom = true;
+    }
+
+    for (size_t i = 0; i < conversations_.size(); i++) {
+        if (conversations_[i].rawSessionId == sessionId_) {
+            selectedConversationIndex_ = static_cast<int>(i);
+            break;
+        }
+    }
+}
+
+void MainWindow::SaveConversationCache() {
+    ConversationCache::Save(ConversationCache::GetCachePath(configPath_),
+                            conversations_, newestConversationId_, sessionId_,
+                            chatViewState_.messages);
 }
 
 void MainWindow::RefreshTasks() {
@@ -132,21 +299,55 @@ void MainWindow::ClearEdit(HWND hEdit) {
 }
 
 void MainWindow::LoadConversationBySessionId(const std::string& sessionId) {
+    // Chuyển session -> response của session cũ (nếu đang bay) không còn ý nghĩa
+    httpClient_.cancelPendingRequests();
+    sendRequestId_++;
+    prefetchInFlightSession_.clear(); // cancel ở trên cũng vô hiệu hóa prefetch đang bay
+
+    // Fast path: transcript đã được prefetch khi hover -> render ngay, không round-trip
+    if (const std::string* cached = transcriptPrefetchCache_.Get(sessionId)) {
+        if (ApplyConversationTranscript(sessionId, *cached)) {
+            return;
+        }
+        // Body cache hỏng (không parse được) -> bỏ và rơi xuống fetch blocking
+        transcriptPrefetchCache_.Erase(sessionId);
+    }
+
     // Load all conversations for this session
     std::string conversationsJson = httpClient_.getConversations(sessionId);
-    
+
     if (conversationsJson.empty() || conversationsJson.find("Error:") == 0) {
         return;
     }
-    
-    chatViewState_.messages.clear();
-    
+
+    if (ApplyConversationTranscript(sessionId, conversationsJson)) {
+        // Click không qua hover (vd keyboard) vẫn nuôi cache - quay lại session
+        // này lần nữa sẽ đi fast path
+        transcriptPrefetchCache_.Put(sessionId, std::move(conversationsJson));
+    }
+}
+
+bool MainWindow::ApplyConversationTranscript(const std::string& sessionId, const std::string& json) {
     // Parse conversations using JsonParser
-    std::vector<nlohmann::json> conversationsArray = JsonParser::ParseArray(conversationsJson);
+    std::vector<nlohmann::json> conversationsArray = JsonParser::ParseArray(json);
     if (conversationsArray.empty()) {
-        return; // Failed to parse or empty array
+        return false; // Failed to parse or empty array
     }
-    
+
+    chatViewState_.messages.clear();
+    // Layout cache chạy song song với messages và staleness cũng chỉ so độ
+    // dài text (EnsureMessageLayout) - message mới cùng index, tình cờ cùng
+    // độ dài sẽ tái dùng chiều cao bubble cũ nếu không xóa ở đây
+    chatViewState_.layouts.clear();
+    chatViewState_.heightPrefix.clear();
+    metadataBlobs_.Clear(); // Transcript thay mới - blob của message cũ bỏ hết
+    // Index search là mirror của messages - transcript thay thì folded text
+    // cũ phải bỏ (SyncEntry chỉ so độ dài, text khác nhưng dài bằng nhau sẽ
+    // bị giữ nguyên), kèm theo kết quả search đang highlight
+    searchIndex_.Clear();
+    searchResults_.clear();
+    currentSearchIndex_ = -1;
+
     std::vector<std::pair<std::wstring, std::wstring>> tempMessages; // (user, ai)
     
     try {
@@ -172,7 +373,7 @@ void MainWindow::LoadConversationBySessionId(const std::string& sessionId) {
     } catch (const std::exception& e) {
         // Log error and return
         JsonParser::LogError("Error parsing conversation messages: " + std::string(e.what()));
-        return;
+        return false;
     }
     
     // Add messages in order (oldest first) using helper functions
@@ -184,13 +385,13 @@ void MainWindow::LoadConversationBySessionId(const std::string& sessionId) {
         }
     }
     
-    sessionId_ = sessionId;
-    
-    // Kill animation timer if active
-    if (chatViewState_.animTimerId_ != 0) {
-        KillTimer(hwnd_, chatViewState_.animTimerId_);
+    SetSessionId(sessionId);
+
+    // Dừng animation đang chạy (nếu có)
+    if (animDriver_) {
+        animDriver_->Stop();
     }
-    
+
     // Reset animation state và đảm bảo input ở dưới cùng khi đã có messages
     chatViewState_.scrollOffset = 0;
     chatViewState_.autoScrollToBottom = true;
@@ -198,21 +399,90 @@ void MainWindow::LoadConversationBySessionId(const std::string& sessionId) {
     chatViewState_.animCurrentY = 0;
     chatViewState_.animTargetY = 0;
     chatViewState_.animStartY = 0;
-    chatViewState_.animTimerId_ = 0;
+    chatViewState_.animElapsedMs = 0.0;
     
     // Gọi OnSize() để cập nhật layout input (sẽ đặt input ở dưới cùng vì messages_ không rỗng)
     OnSize();
     InvalidateRect(hwnd_, NULL, TRUE);
+
+    // Session đang mở đổi -> cập nhật snapshot trên disk
+    SaveConversationCache();
+    return true;
+}
+
+void MainWindow::ScheduleHoverPrefetch() {
+    using namespace UiConstants;
+
+    // Restart timer mỗi lần hover đổi item: lướt chuột dọc sidebar không
+    // bắn request nào, chỉ item mà con trỏ dừng lại mới được prefetch
+    KillTimer(hwnd_, Animation::TIMER_ID_HOVER_PREFETCH);
+    if (hoveredConversationIndex_ >= 0 &&
+        static_cast<size_t>(hoveredConversationIndex_) < conversations_.size()) {
+        SetTimer(hwnd_, Animation::TIMER_ID_HOVER_PREFETCH,
+                 Interaction::HOVER_PREFETCH_DELAY_MS, NULL);
+    }
+}
+
+void MainWindow::StartHoverPrefetch() {
+    if (hoveredConversationIndex_ < 0 ||
+        static_cast<size_t>(hoveredConversationIndex_) >= conversations_.size()) {
+        return; // Hover đã rời sidebar trước khi timer nổ
+    }
+    const std::string& sessionId = conversations_[hoveredConversationIndex_].rawSessionId;
+
+    // Session đang mở thì view đã là bản mới nhất; đã cache hoặc đang bay
+    // thì không bắn trùng
+    if (sessionId.empty() || sessionId == sessionId_ ||
+        transcriptPrefetchCache_.Contains(sessionId) ||
+        prefetchInFlightSession_ == sessionId) {
+        return;
+    }
+
+    prefetchRequestId_++;
+    prefetchInFlightSession_ = sessionId;
+    httpClient_.prefetchConversationsAsync(sessionId, hwnd_,
+                                           UiConstants::Messages::CONVERSATION_PREFETCH,
+                                           prefetchRequestId_);
+}
+
+void MainWindow::OnConversationPrefetchResult(WPARAM requestId, std::string* jsonPtr) {
+    std::unique_ptr<std::string> owned(jsonPtr);
+
+    if (requestId != prefetchRequestId_ || !owned) {
+        return; // Prefetch cũ (đã có prefetch mới hơn đang bay)
+    }
+
+    std::string sessionId = std::move(prefetchInFlightSession_);
+    prefetchInFlightSession_.clear();
+
+    // Prefetch là speculative - fetch fail thì im lặng bỏ qua, click sau đó
+    // vẫn đi đường blocking bình thường
+    if (sessionId.empty() || owned->empty() || owned->find("Error:") == 0) {
+        return;
+    }
+
+    transcriptPrefetchCache_.Put(sessionId, std::move(*owned));
 }
 
 void MainWindow::CheckHealthStatus() {
-    // Set status to checking
-    healthStatus_ = HealthStatus::Checking;
-    InvalidateRect(hwnd_, NULL, FALSE); // Redraw status badge
-    
-    // Call health check endpoint
-    std::string healthResponse = httpClient_.checkHealth();
-    
+    // Probe chạy trên worker thread - backend chết thì WinInet timeout xảy ra
+    // ở worker, UI thread không treo. Badge giữ trạng thái hiện tại trong lúc
+    // đợi kết quả (trạng thái Checking chỉ có trước kết quả đầu tiên).
+    // Kết quả cũ hơn healthRequestId_ hiện hành bị bỏ qua.
+    healthRequestId_++;
+    httpClient_.checkHealthAsync(hwnd_, UiConstants::Messages::HEALTH_RESULT, healthRequestId_);
+}
+
+void MainWindow::OnHealthCheckComplete(WPARAM requestId, std::string* responsePtr) {
+    std::unique_ptr<std::string> owned(responsePtr);
+
+    if (requestId != healthRequestId_ || !owned) {
+        return; // Probe cũ (đã có probe mới hơn đang bay)
+    }
+
+    using namespace UiConstants;
+    const std::string& healthResponse = *owned;
+
     // Parse response using JsonParser
     if (healthResponse.empty() || healthResponse.find("Error:") == 0) {
         healthStatus_ = HealthStatus::Offline;
@@ -226,69 +496,61 @@ void MainWindow::CheckHealthStatus() {
             healthStatus_ = HealthStatus::Offline;
         }
     }
-    
-    // Redraw status badge
-    InvalidateRect(hwnd_, NULL, FALSE);
+
+    // Adaptive backoff: online poll thưa; offline backoff lũy thừa tới trần
+    // để backend chết không tốn connection mỗi vài giây
+    UINT nextInterval;
+    if (healthStatus_ == HealthStatus::Online) {
+        healthOfflineBackoffMs_ = 0;
+        nextInterval = Health::ONLINE_INTERVAL_MS;
+    } else {
+        healthOfflineBackoffMs_ = (healthOfflineBackoffMs_ == 0)
+                                      ? Health::OFFLINE_BASE_INTERVAL_MS
+                                      : healthOfflineBackoffMs_ * 2;
+        if (healthOfflineBackoffMs_ > Health::OFFLINE_MAX_INTERVAL_MS) {
+            healthOfflineBackoffMs_ = Health::OFFLINE_MAX_INTERVAL_MS;
+        }
+        nextInterval = healthOfflineBackoffMs_;
+    }
+    healthCheckTimerId_ = SetTimer(hwnd_, Animation::TIMER_ID_HEALTH_CHECK, nextInterval, NULL);
+
+    // Badge + model name đều nằm trong header - chỉ cần vẽ lại dải đó
+    RECT headerRect = {0, 0, windowWidth_, theme_.headerHeight};
+    InvalidateRect(hwnd_, &headerRect, FALSE);
 }
 
 RECT MainWindow::GetMessageBubbleRect(int messageIndex) {
+    // Không đo đạc gì ở đây: rect suy ra từ layout cache của lần paint gần
+    // nhất (EnsureMessageLayout + heightPrefix) và ChatHitTestGeometry -
+    // O(1), zero GDI, và khớp từng pixel với bubble đã vẽ (bản cũ tự đo
+    // lại bằng font khác nên rect lệch so với màn hình).
     RECT result = {0, 0, 0, 0};
     if (messageIndex < 0 || static_cast<size_t>(messageIndex) >= chatViewState_.messages.size()) {
         return result;
     }
-    
-    RECT clientRect;
-    GetClientRect(hwnd_, &clientRect);
-    int headerH = theme_.headerHeight;
-    int sidebarOffset = sidebarVisible_ ? sidebarWidth_ : 0;
-    int messageAreaTop = headerH + 20;
-    int messageAreaLeft = sidebarOffset;
-    int messageAreaRight = clientRect.right;
-    int userMessageMarginRight = 32;
-    int aiMessageMarginLeft = sidebarVisible_ ? 16 : theme_.messageMarginX;
-    int avatarSize = 20;
-    int avatarMargin = 8;
-    int bubbleOffsetX = avatarSize + avatarMargin;
-    int bubblePaddingX = 18;
-    int bubblePaddingY = 14;
-    int maxBubbleWidth = (int)((messageAreaRight - messageAreaLeft - aiMessageMarginLeft - userMessageMarginRight) * 0.75);
-    
-    int currentY = messageAreaTop - chatViewState_.scrollOffset;
-    int messageMarginY = theme_.messageMarginY;
-    
-    for (int i = 0; i <= messageIndex && static_cast<size_t>(i) < chatViewState_.messages.size(); i++) {
-        const auto& msg = chatViewState_.messages[i];
-        
-        // Estimate bubble size
-        RECT testRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-        auto testFont = gdiManager_->CreateFont(-22, 0, 0, 0, FW_MEDIUM, FALSE, FALSE, FALSE,
-            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-            CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
-        HDC hdc = GetDC(hwnd_);
-        SelectObject(hdc, testFont->Get());
-        DrawTextW(hdc, msg.text.c_str(), -1, &testRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
-        ReleaseDC(hwnd_, hdc);
-        // Smart pointer automatically cleans up
-        
-        int bubbleWidth = testRect.right + 2 * bubblePaddingX;
-        int bubbleHeight = testRect.bottom + 2 * bubblePaddingY + 16;
-        
-        if (i == messageIndex) {
-            if (msg.type == MessageType::User || (msg.type == MessageType::AI && msg.isUser)) {
-                result.left = messageAreaRight - userMessageMarginRight - bubbleWidth;
-                result.right = messageAreaRight - userMessageMarginRight;
-            } else {
-                result.left = messageAreaLeft + aiMessageMarginLeft + bubbleOffsetX;
-                result.right = result.left + bubbleWidth;
-            }
-            result.top = currentY;
-            result.bottom = currentY + bubbleHeight;
-            break;
-        }
-        
-        currentY += bubbleHeight + messageMarginY;
+
+    size_t idx = static_cast<size_t>(messageIndex);
+    if (!chatHitGeometry_.valid || idx >= chatViewState_.layouts.size() ||
+        idx + 1 >= chatViewState_.heightPrefix.size()) {
+        return result; // Chưa paint lần nào -> chưa có gì trên màn hình để hit
     }
-    
+
+    const ChatMessage& msg = chatViewState_.messages[idx];
+    const MessageLayout& layout = chatViewState_.layouts[idx];
+    const ChatHitTestGeometry& geo = chatHitGeometry_;
+
+    result.top = geo.messageAreaTop - chatViewState_.scrollOffset +
+                 chatViewState_.MessageTop(idx);
+    result.bottom = result.top + layout.bubbleHeight;
+
+    if (msg.type == MessageType::User || (msg.type == MessageType::AI && msg.isUser)) {
+        result.right = geo.messageAreaRight - geo.userMessageMarginRight;
+        result.left = result.right - layout.bubbleWidth;
+    } else {
+        result.left = geo.messageAreaLeft + geo.aiMessageMarginLeft + geo.bubbleOffsetX;
+        result.right = result.left + layout.bubbleWidth;
+    }
+
     return result;
 }
 
@@ -321,10 +583,58 @@ RECT MainWindow::GetCopyIconRect(int messageIndex) {
         result.right = result.left + iconSize;
         result.bottom = result.top + iconSize;
     }
-    
+
     return result;
 }
 
+RECT MainWindow::GetSidebarItemRect(int index) {
+    // Cùng geometry với hit test trong HandleMouseMove/HandleLeftButtonDown.
+    // Trả về full-width row (0..sidebarWidth_) để phủ cả padding + glow border.
+    RECT result = {0, 0, 0, 0};
+    if (!sidebarVisible_ || index < 0 ||
+        static_cast<size_t>(index) >= conversations_.size()) {
+        return result;
+    }
+
+    using namespace UiConstants;
+    int headerH = theme_.headerHeight;
+    int titleTop = (newSessionButtonRect_.bottom > 0)
+        ? newSessionButtonRect_.bottom + Sidebar::SPACING_AFTER_BUTTON
+        : headerH + Sidebar::SPACING_FROM_HEADER;
+    int startY = titleTop + Sidebar::TITLE_HEIGHT + Sidebar::SPACING_AFTER_TITLE;
+
+    result.top = startY - sidebarScrollOffset_ + index * Sidebar::ITEM_HEIGHT;
+    result.bottom = result.top + Sidebar::ITEM_HEIGHT;
+    result.left = 0;
+    result.right = sidebarWidth_;
+    return result;
+}
+
+void MainWindow::InvalidateSidebarItem(int index) {
+    RECT itemRect = GetSidebarItemRect(index);
+    if (itemRect.bottom > itemRect.top) {
+        InvalidateRect(hwnd_, &itemRect, FALSE);
+    }
+}
+
+void MainWindow::InvalidateMessageHover(int messageIndex) {
+    if (messageIndex < 0) {
+        return;
+    }
+    RECT bubbleRect = GetMessageBubbleRect(messageIndex);
+    if (bubbleRect.right <= bubbleRect.left) {
+        return; // Chưa từng paint -> chưa có gì trên màn hình để xóa
+    }
+    // Icon copy nằm ngoài mép bubble nên phải union vào vùng dirty
+    RECT iconRect = GetCopyIconRect(messageIndex);
+    RECT dirty;
+    UnionRect(&dirty, &bubbleRect, &iconRect);
+    // Nới một chút cho border hover/vùng feedback quanh icon
+    InflateRect(&dirty, UiConstants::Message::ICON_INFLATE_SIZE,
+                UiConstants::Message::ICON_INFLATE_SIZE);
+    InvalidateRect(hwnd_, &dirty, FALSE);
+}
+
 void MainWindow::CopyMessageToClipboard(int messageIndex) {
     if (messageIndex < 0 || static_cast<size_t>(messageIndex) >= chatViewState_.messages.size()) {
         return;
@@ -401,7 +711,22 @@ void MainWindow::ShowMessageTooltip(int messageIndex, int x, int y) {
     if (!metadata.modelName.empty()) {
         tooltipText += L"Model: " + metadata.modelName;
     }
-    
+
+    // Bubble lỗi: rehydrate body gốc từ blob store - giải nén đúng lúc
+    // user hover chứ không giữ plain text suốt vòng đời conversation
+    if (msg.type == MessageType::Error && metadata.rawJsonBlob != 0) {
+        std::wstring raw = Utf8ToWide(metadataBlobs_.Get(metadata.rawJsonBlob));
+        if (!raw.empty()) {
+            if (raw.length() > 200) {
+                raw = raw.substr(0, 197) + L"...";
+            }
+            if (!tooltipText.empty() && tooltipText.back() != L'\n') {
+                tooltipText += L"\n";
+            }
+            tooltipText += raw;
+        }
+    }
+
     if (tooltipText.empty()) {
         return; // No metadata to show
     }
@@ -450,78 +775,41 @@ void MainWindow::HideMessageTooltip() {
 }
 
 void MainWindow::UpdateMessageHover(int x, int y) {
-    // Calculate which message bubble is being hovered
+    // Chạy trên mỗi WM_MOUSEMOVE nên phải rẻ: đổi y chuột sang tọa độ
+    // nội dung rồi binary search trên heightPrefix tìm band chứa nó -
+    // chỉ đúng một message là candidate, rect của nó lấy từ layout cache
+    // (GetMessageBubbleRect). O(log n), zero GDI.
     int newHoveredIndex = -1;
     int newHoveredCopyIconIndex = -1;
-    
-    RECT clientRect;
-    GetClientRect(hwnd_, &clientRect);
-    int headerH = theme_.headerHeight;
-    int sidebarOffset = sidebarVisible_ ? sidebarWidth_ : 0;
-    int messageAreaTop = headerH + 20;
-    int messageAreaLeft = sidebarOffset;
-    int messageAreaRight = clientRect.right;
-    int userMessageMarginRight = 32;
-    int aiMessageMarginLeft = sidebarVisible_ ? 16 : theme_.messageMarginX;
-    int avatarSize = 20;
-    int avatarMargin = 8;
-    int bubbleOffsetX = avatarSize + avatarMargin;
-    int bubblePaddingX = 18;
-    int bubblePaddingY = 14;
-    int maxBubbleWidth = (int)((messageAreaRight - messageAreaLeft - aiMessageMarginLeft - userMessageMarginRight) * 0.75);
-    
-    int currentY = messageAreaTop - chatViewState_.scrollOffset;
-    int messageMarginY = theme_.messageMarginY;
-    
-    for (size_t i = 0; i < chatViewState_.messages.size(); i++) {
-        const auto& msg = chatViewState_.messages[i];
-        
-        // Estimate bubble size (simplified)
-        RECT testRect = {0, 0, maxBubbleWidth - 2 * bubblePaddingX, 0};
-        auto testFont = gdiManager_->CreateFont(-22, 0, 0, 0, FW_MEDIUM, FALSE, FALSE, FALSE,
-            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-            CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
-        HDC hdc = GetDC(hwnd_);
-        SelectObject(hdc, testFont->Get());
-        DrawTextW(hdc, msg.text.c_str(), -1, &testRect, DT_LEFT | DT_WORDBREAK | DT_CALCRECT);
-        ReleaseDC(hwnd_, hdc);
-        // Smart pointer automatically cleans up
-        
-        int bubbleWidth = testRect.right + 2 * bubblePaddingX;
-        int bubbleHeight = testRect.bottom + 2 * bubblePaddingY + 16;
-        
-        RECT bubbleRect;
-        if (msg.type == MessageType::User || (msg.type == MessageType::AI && msg.isUser)) {
-            bubbleRect.left = messageAreaRight - userMessageMarginRight - bubbleWidth;
-            bubbleRect.right = messageAreaRight - userMessageMarginRight;
-        } else {
-            bubbleRect.left = messageAreaLeft + aiMessageMarginLeft + bubbleOffsetX;
-            bubbleRect.right = bubbleRect.left + bubbleWidth;
-        }
-        bubbleRect.top = currentY;
-        bubbleRect.bottom = currentY + bubbleHeight;
-        
-        // Check if hovering over copy icon
-        RECT copyIconRect = GetCopyIconRect(static_cast<int>(i));
-        if (x >= copyIconRect.left && x <= copyIconRect.right &&
-            y >= copyIconRect.top && y <= copyIconRect.bottom) {
-            newHoveredCopyIconIndex = static_cast<int>(i);
-            newHoveredIndex = static_cast<int>(i); // Also highlight bubble
-        } else if (x >= bubbleRect.left && x <= bubbleRect.right &&
-                   y >= bubbleRect.top && y <= bubbleRect.bottom) {
-            newHoveredIndex = static_cast<int>(i);
-            // Show tooltip with metadata
-            ShowMessageTooltip(static_cast<int>(i), x, y);
+
+    if (chatHitGeometry_.valid &&
+        chatViewState_.heightPrefix.size() == chatViewState_.messages.size() + 1) {
+        int contentY = y - chatHitGeometry_.messageAreaTop + chatViewState_.scrollOffset;
+        if (contentY >= 0 && contentY < chatViewState_.TotalMessagesHeight()) {
+            size_t idx = chatViewState_.FirstVisibleMessage(contentY);
+            if (idx < chatViewState_.messages.size()) {
+                POINT pt = {x, y};
+                RECT copyIconRect = GetCopyIconRect(static_cast<int>(idx));
+                RECT bubbleRect = GetMessageBubbleRect(static_cast<int>(idx));
+                // Icon copy nằm trong band dọc của bubble nên cùng candidate
+                if (PtInRect(&copyIconRect, pt)) {
+                    newHoveredCopyIconIndex = static_cast<int>(idx);
+                    newHoveredIndex = static_cast<int>(idx); // Also highlight bubble
+                } else if (PtInRect(&bubbleRect, pt)) {
+                    newHoveredIndex = static_cast<int>(idx);
+                    // Show tooltip with metadata
+                    ShowMessageTooltip(static_cast<int>(idx), x, y);
+                }
+            }
         }
-        
-        currentY += bubbleHeight + messageMarginY;
     }
-    
+
     // Hide tooltip if not hovering any message
     if (newHoveredIndex == -1) {
         HideMessageTooltip();
     }
     
+    int oldHoveredIndex = hoveredMessageIndex_;
     bool needsRedraw = false;
     if (newHoveredIndex != hoveredMessageIndex_) {
         hoveredMessageIndex_ = newHoveredIndex;
@@ -531,8 +819,14 @@ void MainWindow::UpdateMessageHover(int x, int y) {
         hoveredCopyIconIndex_ = newHoveredCopyIconIndex;
         needsRedraw = true;
     }
-    
+
     if (needsRedraw) {
-        InvalidateRect(hwnd_, NULL, FALSE); // Redraw to show hover effect
+        // Chỉ bubble cũ và bubble mới bị đổi diện mạo - invalidate đúng
+        // hai rect đó thay vì cả window (icon đổi trong cùng bubble thì
+        // một rect là đủ)
+        InvalidateMessageHover(oldHoveredIndex);
+        if (newHoveredIndex != oldHoveredIndex) {
+            InvalidateMessageHover(newHoveredIndex);
+        }
     }
 }
\ No newline at end of file
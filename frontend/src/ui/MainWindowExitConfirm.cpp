@@ -3,6 +3,7 @@
 #include <dwmapi.h>
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
+#include "../core/GDIResourceManager.h"
 #include <string>
 
 // Exit confirmation dialog implementation
@@ -61,30 +62,28 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             HBITMAP hbmMem = CreateCompatibleBitmap(hdc, clientRect.right, clientRect.bottom);
             HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
             
+            // Font/brush/pen lấy từ cache process-wide - không DeleteObject
+            GDIResourceManager& gdiCache = GDIResourceManager::Shared();
+
             // Fill dark background
-            HBRUSH bgBrush = CreateSolidBrush(RGB(16, 22, 40));
+            HBRUSH bgBrush = gdiCache.GetBrush(RGB(16, 22, 40));
             FillRect(hdcMem, &clientRect, bgBrush);
-            DeleteObject(bgBrush);
-            
+
             // Draw header with cyan line
             RECT headerRect = {0, 0, clientRect.right, 40};
-            HBRUSH headerBrush = CreateSolidBrush(RGB(16, 22, 40));
-            FillRect(hdcMem, &headerRect, headerBrush);
-            DeleteObject(headerBrush);
-            
+            FillRect(hdcMem, &headerRect, bgBrush);
+
             // Draw title first (before the line)
             SetBkMode(hdcMem, TRANSPARENT);
             SetTextColor(hdcMem, RGB(232, 236, 255));
-            HFONT hTitleFont = CreateFontW(-20, 0, 0, 0, FW_SEMIBOLD, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hTitleFont = gdiCache.GetFont(-20, FW_SEMIBOLD, L"Segoe UI");
             HFONT hOldFont = (HFONT)SelectObject(hdcMem, hTitleFont);
             RECT titleRect = {20, 0, clientRect.right - 40, 40};  // Leave space for close button
             DrawTextW(hdcMem, UiStrings::Get(IDS_EXIT_CONFIRM_TITLE).c_str(), -1, &titleRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
             
             // Draw close button (X) in title bar
             COLORREF closeColor = pData->isCloseHover ? RGB(255, 100, 100) : RGB(200, 210, 230);
-            HPEN closePen = CreatePen(PS_SOLID, 2, closeColor);
+            HPEN closePen = gdiCache.GetPen(PS_SOLID, 2, closeColor);
             HGDIOBJ oldClosePen = SelectObject(hdcMem, closePen);
             int closeCenterX = (pData->closeRect.left + pData->closeRect.right) / 2;
             int closeCenterY = (pData->closeRect.top + pData->closeRect.bottom) / 2;
@@ -94,18 +93,15 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             MoveToEx(hdcMem, closeCenterX + closeSize/2, closeCenterY - closeSize/2, NULL);
             LineTo(hdcMem, closeCenterX - closeSize/2, closeCenterY + closeSize/2);
             SelectObject(hdcMem, oldClosePen);
-            DeleteObject(closePen);
-            
+
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hTitleFont);
-            
+
             // Draw cyan line at the bottom of header (after title)
-            HPEN headerPen = CreatePen(PS_SOLID, 1, RGB(74, 215, 255));
+            HPEN headerPen = gdiCache.GetPen(PS_SOLID, 1, RGB(74, 215, 255));
             HGDIOBJ oldPen = SelectObject(hdcMem, headerPen);
             MoveToEx(hdcMem, 0, headerRect.bottom - 1, NULL);
             LineTo(hdcMem, clientRect.right, headerRect.bottom - 1);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(headerPen);
             
             // Draw question mark icon (circular with question mark)
             int iconSize = 48;
@@ -114,8 +110,8 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             RECT iconRect = {iconX, iconY, iconX + iconSize, iconY + iconSize};
             
             // Draw icon background (cyan circle)
-            HBRUSH iconBrush = CreateSolidBrush(RGB(74, 215, 255));
-            HPEN iconPen = CreatePen(PS_SOLID, 2, RGB(74, 215, 255));
+            HBRUSH iconBrush = gdiCache.GetBrush(RGB(74, 215, 255));
+            HPEN iconPen = gdiCache.GetPen(PS_SOLID, 2, RGB(74, 215, 255));
             HGDIOBJ oldIconBrush = SelectObject(hdcMem, iconBrush);
             HGDIOBJ oldIconPen = SelectObject(hdcMem, iconPen);
             Ellipse(hdcMem, iconRect.left, iconRect.top, iconRect.right, iconRect.bottom);
@@ -123,24 +119,17 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             // Draw question mark (white)
             SetTextColor(hdcMem, RGB(0, 0, 0));
             SetBkMode(hdcMem, TRANSPARENT);
-            HFONT hIconFont = CreateFontW(-32, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hIconFont = gdiCache.GetFont(-32, FW_BOLD, L"Segoe UI");
             HFONT hOldIconFont = (HFONT)SelectObject(hdcMem, hIconFont);
             RECT questionRect = {iconX, iconY, iconX + iconSize, iconY + iconSize};
             DrawTextW(hdcMem, L"?", -1, &questionRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
             SelectObject(hdcMem, hOldIconFont);
-            DeleteObject(hIconFont);
-            
+
             SelectObject(hdcMem, oldIconBrush);
             SelectObject(hdcMem, oldIconPen);
-            DeleteObject(iconBrush);
-            DeleteObject(iconPen);
-            
+
             // Draw message text
-            HFONT hLabelFont = CreateFontW(-16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hLabelFont = gdiCache.GetFont(-16, FW_NORMAL, L"Segoe UI");
             hOldFont = (HFONT)SelectObject(hdcMem, hLabelFont);
             SetTextColor(hdcMem, RGB(232, 236, 255));
             RECT messageRect = {iconX + iconSize + 20, iconY, clientRect.right - 20, iconY + iconSize + 20};
@@ -154,15 +143,13 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             COLORREF yesBorder = RGB(74, 215, 255);
             COLORREF yesText = pData->isYesHover ? RGB(0, 0, 0) : RGB(232, 236, 255);
             
-            HBRUSH yesBrush = CreateSolidBrush(yesBg);
-            HPEN yesPen = CreatePen(PS_SOLID, 1, yesBorder);
+            HBRUSH yesBrush = gdiCache.GetBrush(yesBg);
+            HPEN yesPen = gdiCache.GetPen(PS_SOLID, 1, yesBorder);
             HGDIOBJ oldBrush = SelectObject(hdcMem, yesBrush);
             oldPen = SelectObject(hdcMem, yesPen);
             RoundRect(hdcMem, pData->yesRect.left, pData->yesRect.top, pData->yesRect.right, pData->yesRect.bottom, radius, radius);
             SelectObject(hdcMem, oldBrush);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(yesBrush);
-            DeleteObject(yesPen);
             
             SetTextColor(hdcMem, yesText);
             DrawTextW(hdcMem, UiStrings::Get(IDS_YES_BUTTON).c_str(), -1, &pData->yesRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
@@ -172,20 +159,17 @@ LRESULT CALLBACK MainWindow::ExitConfirmDlgProc(HWND hwnd, UINT uMsg, WPARAM wPa
             COLORREF noBorder = RGB(60, 90, 130);
             COLORREF noText = RGB(200, 210, 230);
             
-            HBRUSH noBrush = CreateSolidBrush(noBg);
-            HPEN noPen = CreatePen(PS_SOLID, 1, noBorder);
+            HBRUSH noBrush = gdiCache.GetBrush(noBg);
+            HPEN noPen = gdiCache.GetPen(PS_SOLID, 1, noBorder);
             oldBrush = SelectObject(hdcMem, noBrush);
             oldPen = SelectObject(hdcMem, noPen);
             RoundRect(hdcMem, pData->noRect.left, pData->noRect.top, pData->noRect.right, pData->noRect.bottom, radius, radius);
             SelectObject(hdcMem, oldBrush);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(noBrush);
-            DeleteObject(noPen);
-            
+
             SetTextColor(hdcMem, noText);
             DrawTextW(hdcMem, UiStrings::Get(IDS_NO_BUTTON).c_str(), -1, &pData->noRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hLabelFont);
             
             // Blit to screen
             BitBlt(hdc, 0, 0, clientRect.right, clientRect.bottom, hdcMem, 0, 0, SRCCOPY);
@@ -5,7 +5,18 @@
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
 #include "../core/ExportService.h"
+#include "../core/GDIResourceManager.h"
 #include <string>
+#include <thread>
+
+namespace {
+    // Message nội bộ của export dialog (thread export -> dialog). Cùng
+    // WM_APP range nhưng tách số với UiConstants::Messages vì khác cửa sổ.
+    // wParam = số conversation đã fetch, lParam = số session đã ghi
+    constexpr UINT EXPORT_PROGRESS = WM_APP + 20;
+    // wParam = 1 nếu thành công, 0 nếu lỗi
+    constexpr UINT EXPORT_DONE = WM_APP + 21;
+}
 
 // Export dialog structure
 struct ExportDlgData {
@@ -27,6 +38,11 @@ struct ExportDlgData {
     RECT exportRect;
     RECT cancelRect;
     bool shouldClose;
+    // Export all chạy nền: dialog khóa input và vẽ dòng tiến độ cho tới
+    // khi EXPORT_DONE về
+    bool exportInProgress;
+    size_t progressFetched;   // số conversation đã fetch từ backend
+    size_t progressWritten;   // số session đã ghi ra file
 };
 
 LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -62,8 +78,11 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 // Buttons - positioned with more space from bottom
                 pData->exportRect = {280, 250, 360, 282};
                 pData->cancelRect = {370, 250, 450, 282};
-                
+
                 pData->shouldClose = false;
+                pData->exportInProgress = false;
+                pData->progressFetched = 0;
+                pData->progressWritten = 0;
             }
             
             return 0;
@@ -81,42 +100,37 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
             HBITMAP hbmMem = CreateCompatibleBitmap(hdc, clientRect.right, clientRect.bottom);
             HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
             
+            // Font/brush/pen lấy từ cache process-wide - handle do cache
+            // sở hữu, không DeleteObject trong proc này
+            GDIResourceManager& gdiCache = GDIResourceManager::Shared();
+
             // Fill dark background
-            HBRUSH bgBrush = CreateSolidBrush(RGB(16, 22, 40));
+            HBRUSH bgBrush = gdiCache.GetBrush(RGB(16, 22, 40));
             FillRect(hdcMem, &clientRect, bgBrush);
-            DeleteObject(bgBrush);
-            
+
             // Draw header
             RECT headerRect = {0, 0, clientRect.right, 40};
-            HBRUSH headerBrush = CreateSolidBrush(RGB(16, 22, 40));
-            FillRect(hdcMem, &headerRect, headerBrush);
-            DeleteObject(headerBrush);
-            
+            FillRect(hdcMem, &headerRect, bgBrush);
+
             // Draw title
             SetBkMode(hdcMem, TRANSPARENT);
             SetTextColor(hdcMem, RGB(232, 236, 255));
-            HFONT hTitleFont = CreateFontW(-20, 0, 0, 0, FW_SEMIBOLD, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hTitleFont = gdiCache.GetFont(-20, FW_SEMIBOLD, L"Segoe UI");
             HFONT hOldFont = (HFONT)SelectObject(hdcMem, hTitleFont);
             RECT titleRect = {20, 0, clientRect.right, 40};
             DrawTextW(hdcMem, UiStrings::Get(IDS_EXPORT_TITLE).c_str(), -1, &titleRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hTitleFont);
-            
+
             // Draw cyan line
-            HPEN headerPen = CreatePen(PS_SOLID, 1, RGB(74, 215, 255));
+            HPEN headerPen = gdiCache.GetPen(PS_SOLID, 1, RGB(74, 215, 255));
             HGDIOBJ oldPen = SelectObject(hdcMem, headerPen);
             MoveToEx(hdcMem, 0, headerRect.bottom - 1, NULL);
             LineTo(hdcMem, clientRect.right, headerRect.bottom - 1);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(headerPen);
-            
+
             if (pData) {
                 // Draw labels
-                HFONT hLabelFont = CreateFontW(-16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                    DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                    CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+                HFONT hLabelFont = gdiCache.GetFont(-16, FW_NORMAL, L"Segoe UI");
                 hOldFont = (HFONT)SelectObject(hdcMem, hLabelFont);
                 SetTextColor(hdcMem, RGB(200, 210, 230));
                 
@@ -127,8 +141,7 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 DrawTextW(hdcMem, UiStrings::Get(IDS_EXPORT_SCOPE_LABEL).c_str(), -1, &scopeLabelRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
                 
                 SelectObject(hdcMem, hOldFont);
-                DeleteObject(hLabelFont);
-                
+
                 // Draw format radio buttons
                 int radioSize = 16;
                 int radioX = pData->formatTxtRect.left;
@@ -139,22 +152,19 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 COLORREF radioColor = (pData->selectedFormat == ExportFormat::TXT) ? RGB(74, 215, 255) : RGB(60, 90, 130);
                 if (pData->isFormatTxtHover) radioColor = RGB(100, 150, 200);
                 
-                HBRUSH radioBrush = CreateSolidBrush((pData->selectedFormat == ExportFormat::TXT) ? radioColor : RGB(18, 24, 42));
-                HPEN radioPen = CreatePen(PS_SOLID, 1, radioColor);
+                HBRUSH radioBrush = gdiCache.GetBrush((pData->selectedFormat == ExportFormat::TXT) ? radioColor : RGB(18, 24, 42));
+                HPEN radioPen = gdiCache.GetPen(PS_SOLID, 1, radioColor);
                 HGDIOBJ oldRadioBrush = SelectObject(hdcMem, radioBrush);
                 HGDIOBJ oldRadioPen = SelectObject(hdcMem, radioPen);
                 Ellipse(hdcMem, txtRadio.left, txtRadio.top, txtRadio.right, txtRadio.bottom);
                 if (pData->selectedFormat == ExportFormat::TXT) {
                     // Draw inner circle
-                    HBRUSH innerBrush = CreateSolidBrush(RGB(74, 215, 255));
+                    HBRUSH innerBrush = gdiCache.GetBrush(RGB(74, 215, 255));
                     SelectObject(hdcMem, innerBrush);
                     Ellipse(hdcMem, txtRadio.left + 4, txtRadio.top + 4, txtRadio.right - 4, txtRadio.bottom - 4);
-                    DeleteObject(innerBrush);
                 }
                 SelectObject(hdcMem, oldRadioBrush);
                 SelectObject(hdcMem, oldRadioPen);
-                DeleteObject(radioBrush);
-                DeleteObject(radioPen);
                 
                 SetTextColor(hdcMem, RGB(232, 236, 255));
                 RECT txtLabel = {radioX + radioSize + 10, pData->formatTxtRect.top, pData->formatTxtRect.right, pData->formatTxtRect.bottom};
@@ -166,21 +176,18 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 radioColor = (pData->selectedFormat == ExportFormat::Markdown) ? RGB(74, 215, 255) : RGB(60, 90, 130);
                 if (pData->isFormatMdHover) radioColor = RGB(100, 150, 200);
                 
-                radioBrush = CreateSolidBrush((pData->selectedFormat == ExportFormat::Markdown) ? radioColor : RGB(18, 24, 42));
-                radioPen = CreatePen(PS_SOLID, 1, radioColor);
+                radioBrush = gdiCache.GetBrush((pData->selectedFormat == ExportFormat::Markdown) ? radioColor : RGB(18, 24, 42));
+                radioPen = gdiCache.GetPen(PS_SOLID, 1, radioColor);
                 oldRadioBrush = SelectObject(hdcMem, radioBrush);
                 oldRadioPen = SelectObject(hdcMem, radioPen);
                 Ellipse(hdcMem, mdRadio.left, mdRadio.top, mdRadio.right, mdRadio.bottom);
                 if (pData->selectedFormat == ExportFormat::Markdown) {
-                    HBRUSH innerBrush = CreateSolidBrush(RGB(74, 215, 255));
+                    HBRUSH innerBrush = gdiCache.GetBrush(RGB(74, 215, 255));
                     SelectObject(hdcMem, innerBrush);
                     Ellipse(hdcMem, mdRadio.left + 4, mdRadio.top + 4, mdRadio.right - 4, mdRadio.bottom - 4);
-                    DeleteObject(innerBrush);
                 }
                 SelectObject(hdcMem, oldRadioBrush);
                 SelectObject(hdcMem, oldRadioPen);
-                DeleteObject(radioBrush);
-                DeleteObject(radioPen);
                 
                 RECT mdLabel = {radioX + radioSize + 10, pData->formatMdRect.top, pData->formatMdRect.right, pData->formatMdRect.bottom};
                 DrawTextW(hdcMem, L"Markdown (.md)", -1, &mdLabel, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
@@ -191,21 +198,18 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 radioColor = (pData->selectedFormat == ExportFormat::JSON) ? RGB(74, 215, 255) : RGB(60, 90, 130);
                 if (pData->isFormatJsonHover) radioColor = RGB(100, 150, 200);
                 
-                radioBrush = CreateSolidBrush((pData->selectedFormat == ExportFormat::JSON) ? radioColor : RGB(18, 24, 42));
-                radioPen = CreatePen(PS_SOLID, 1, radioColor);
+                radioBrush = gdiCache.GetBrush((pData->selectedFormat == ExportFormat::JSON) ? radioColor : RGB(18, 24, 42));
+                radioPen = gdiCache.GetPen(PS_SOLID, 1, radioColor);
                 oldRadioBrush = SelectObject(hdcMem, radioBrush);
                 oldRadioPen = SelectObject(hdcMem, radioPen);
                 Ellipse(hdcMem, jsonRadio.left, jsonRadio.top, jsonRadio.right, jsonRadio.bottom);
                 if (pData->selectedFormat == ExportFormat::JSON) {
-                    HBRUSH innerBrush = CreateSolidBrush(RGB(74, 215, 255));
+                    HBRUSH innerBrush = gdiCache.GetBrush(RGB(74, 215, 255));
                     SelectObject(hdcMem, innerBrush);
                     Ellipse(hdcMem, jsonRadio.left + 4, jsonRadio.top + 4, jsonRadio.right - 4, jsonRadio.bottom - 4);
-                    DeleteObject(innerBrush);
                 }
                 SelectObject(hdcMem, oldRadioBrush);
                 SelectObject(hdcMem, oldRadioPen);
-                DeleteObject(radioBrush);
-                DeleteObject(radioPen);
                 
                 RECT jsonLabel = {radioX + radioSize + 10, pData->formatJsonRect.top, pData->formatJsonRect.right, pData->formatJsonRect.bottom};
                 DrawTextW(hdcMem, L"JSON (.json)", -1, &jsonLabel, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
@@ -217,21 +221,18 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 radioColor = (pData->selectedScope == ExportScope::CurrentConversation) ? RGB(74, 215, 255) : RGB(60, 90, 130);
                 if (pData->isScopeCurrentHover) radioColor = RGB(100, 150, 200);
                 
-                radioBrush = CreateSolidBrush((pData->selectedScope == ExportScope::CurrentConversation) ? radioColor : RGB(18, 24, 42));
-                radioPen = CreatePen(PS_SOLID, 1, radioColor);
+                radioBrush = gdiCache.GetBrush((pData->selectedScope == ExportScope::CurrentConversation) ? radioColor : RGB(18, 24, 42));
+                radioPen = gdiCache.GetPen(PS_SOLID, 1, radioColor);
                 oldRadioBrush = SelectObject(hdcMem, radioBrush);
                 oldRadioPen = SelectObject(hdcMem, radioPen);
                 Ellipse(hdcMem, currentRadio.left, currentRadio.top, currentRadio.right, currentRadio.bottom);
                 if (pData->selectedScope == ExportScope::CurrentConversation) {
-                    HBRUSH innerBrush = CreateSolidBrush(RGB(74, 215, 255));
+                    HBRUSH innerBrush = gdiCache.GetBrush(RGB(74, 215, 255));
                     SelectObject(hdcMem, innerBrush);
                     Ellipse(hdcMem, currentRadio.left + 4, currentRadio.top + 4, currentRadio.right - 4, currentRadio.bottom - 4);
-                    DeleteObject(innerBrush);
                 }
                 SelectObject(hdcMem, oldRadioBrush);
                 SelectObject(hdcMem, oldRadioPen);
-                DeleteObject(radioBrush);
-                DeleteObject(radioPen);
                 
                 RECT currentLabel = {radioX + radioSize + 10, pData->scopeCurrentRect.top, pData->scopeCurrentRect.right, pData->scopeCurrentRect.bottom};
                 DrawTextW(hdcMem, UiStrings::Get(IDS_EXPORT_CURRENT).c_str(), -1, &currentLabel, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
@@ -242,21 +243,18 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 radioColor = (pData->selectedScope == ExportScope::AllConversations) ? RGB(74, 215, 255) : RGB(60, 90, 130);
                 if (pData->isScopeAllHover) radioColor = RGB(100, 150, 200);
                 
-                radioBrush = CreateSolidBrush((pData->selectedScope == ExportScope::AllConversations) ? radioColor : RGB(18, 24, 42));
-                radioPen = CreatePen(PS_SOLID, 1, radioColor);
+                radioBrush = gdiCache.GetBrush((pData->selectedScope == ExportScope::AllConversations) ? radioColor : RGB(18, 24, 42));
+                radioPen = gdiCache.GetPen(PS_SOLID, 1, radioColor);
                 oldRadioBrush = SelectObject(hdcMem, radioBrush);
                 oldRadioPen = SelectObject(hdcMem, radioPen);
                 Ellipse(hdcMem, allRadio.left, allRadio.top, allRadio.right, allRadio.bottom);
                 if (pData->selectedScope == ExportScope::AllConversations) {
-                    HBRUSH innerBrush = CreateSolidBrush(RGB(74, 215, 255));
+                    HBRUSH innerBrush = gdiCache.GetBrush(RGB(74, 215, 255));
                     SelectObject(hdcMem, innerBrush);
                     Ellipse(hdcMem, allRadio.left + 4, allRadio.top + 4, allRadio.right - 4, allRadio.bottom - 4);
-                    DeleteObject(innerBrush);
                 }
                 SelectObject(hdcMem, oldRadioBrush);
                 SelectObject(hdcMem, oldRadioPen);
-                DeleteObject(radioBrush);
-                DeleteObject(radioPen);
                 
                 RECT allLabel = {radioX + radioSize + 10, pData->scopeAllRect.top, pData->scopeAllRect.right, pData->scopeAllRect.bottom};
                 DrawTextW(hdcMem, UiStrings::Get(IDS_EXPORT_ALL).c_str(), -1, &allLabel, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
@@ -267,15 +265,13 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 COLORREF exportBorder = RGB(74, 215, 255);
                 COLORREF exportText = pData->isExportHover ? RGB(0, 0, 0) : RGB(232, 236, 255);
                 
-                HBRUSH exportBrush = CreateSolidBrush(exportBg);
-                HPEN exportPen = CreatePen(PS_SOLID, 1, exportBorder);
+                HBRUSH exportBrush = gdiCache.GetBrush(exportBg);
+                HPEN exportPen = gdiCache.GetPen(PS_SOLID, 1, exportBorder);
                 HGDIOBJ oldBrush = SelectObject(hdcMem, exportBrush);
                 oldPen = SelectObject(hdcMem, exportPen);
                 RoundRect(hdcMem, pData->exportRect.left, pData->exportRect.top, pData->exportRect.right, pData->exportRect.bottom, radius, radius);
                 SelectObject(hdcMem, oldBrush);
                 SelectObject(hdcMem, oldPen);
-                DeleteObject(exportBrush);
-                DeleteObject(exportPen);
                 
                 SetTextColor(hdcMem, exportText);
                 hOldFont = (HFONT)SelectObject(hdcMem, hLabelFont);
@@ -285,18 +281,27 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 COLORREF cancelBorder = RGB(60, 90, 130);
                 COLORREF cancelText = RGB(200, 210, 230);
                 
-                HBRUSH cancelBrush = CreateSolidBrush(cancelBg);
-                HPEN cancelPen = CreatePen(PS_SOLID, 1, cancelBorder);
+                HBRUSH cancelBrush = gdiCache.GetBrush(cancelBg);
+                HPEN cancelPen = gdiCache.GetPen(PS_SOLID, 1, cancelBorder);
                 oldBrush = SelectObject(hdcMem, cancelBrush);
                 oldPen = SelectObject(hdcMem, cancelPen);
                 RoundRect(hdcMem, pData->cancelRect.left, pData->cancelRect.top, pData->cancelRect.right, pData->cancelRect.bottom, radius, radius);
                 SelectObject(hdcMem, oldBrush);
                 SelectObject(hdcMem, oldPen);
-                DeleteObject(cancelBrush);
-                DeleteObject(cancelPen);
                 
                 SetTextColor(hdcMem, cancelText);
                 DrawTextW(hdcMem, UiStrings::Get(IDS_CANCEL_BUTTON).c_str(), -1, &pData->cancelRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+
+                // Dòng tiến độ khi export all đang chạy nền
+                if (pData->exportInProgress) {
+                    wchar_t progressText[128];
+                    swprintf_s(progressText, UiStrings::Get(IDS_EXPORT_PROGRESS).c_str(),
+                               pData->progressFetched, pData->progressWritten);
+                    SetTextColor(hdcMem, RGB(74, 215, 255));
+                    RECT progressRect = {20, 250, 270, 282};
+                    DrawTextW(hdcMem, progressText, -1, &progressRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
+                }
+
                 SelectObject(hdcMem, hOldFont);
             }
             
@@ -349,8 +354,10 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
         
         case WM_LBUTTONDOWN: {
             if (!pData) break;
+            // Đang export nền: bỏ qua mọi click (kể cả Cancel) cho tới khi xong
+            if (pData->exportInProgress) return 0;
             POINT pt = {GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam)};
-            
+
             // Handle format selection
             if (PtInRect(&pData->formatTxtRect, pt)) {
                 pData->selectedFormat = ExportFormat::TXT;
@@ -407,16 +414,35 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
                 
                 if (GetSaveFileNameW(&ofn)) {
                     std::wstring filePath = szFile;
+
+                    if (pData->pMainWindow && pData->selectedScope == ExportScope::AllConversations) {
+                        // Export all chạy trên thread riêng - coordinator của
+                        // pipeline blocking chờ fetch/convert của chính nó nên
+                        // không để nó chiếm một worker của TaskScheduler suốt
+                        // nhiều phút. Tiến độ/kết quả về qua PostMessageW;
+                        // dialog khóa input cho tới khi EXPORT_DONE.
+                        pData->exportInProgress = true;
+                        pData->progressFetched = 0;
+                        pData->progressWritten = 0;
+                        MainWindow* pMain = pData->pMainWindow;
+                        ExportFormat fmt = pData->selectedFormat;
+                        std::thread([pMain, filePath, fmt, hwnd]() {
+                            bool ok = pMain->ExportAllConversations(filePath, fmt,
+                                [hwnd](size_t fetched, size_t written) {
+                                    PostMessageW(hwnd, EXPORT_PROGRESS,
+                                                 (WPARAM)fetched, (LPARAM)written);
+                                });
+                            PostMessageW(hwnd, EXPORT_DONE, ok ? 1 : 0, 0);
+                        }).detach();
+                        InvalidateRect(hwnd, NULL, FALSE);
+                        return 0;
+                    }
+
                     bool success = false;
-                    
                     if (pData->pMainWindow) {
-                        if (pData->selectedScope == ExportScope::CurrentConversation) {
-                            success = pData->pMainWindow->ExportCurrentConversation(filePath, pData->selectedFormat);
-                        } else {
-                            success = pData->pMainWindow->ExportAllConversations(filePath, pData->selectedFormat);
-                        }
+                        success = pData->pMainWindow->ExportCurrentConversation(filePath, pData->selectedFormat);
                     }
-                    
+
                     if (success) {
                         if (pData->pMainWindow) {
                             pData->pMainWindow->ShowExportMessageDialog(UiStrings::Get(IDS_EXPORT_SUCCESS), true);
@@ -438,13 +464,44 @@ LRESULT CALLBACK MainWindow::ExportDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam,
             break;
         }
         
+        case EXPORT_PROGRESS: {
+            if (pData) {
+                pData->progressFetched = (size_t)wParam;
+                pData->progressWritten = (size_t)lParam;
+                InvalidateRect(hwnd, NULL, FALSE);
+            }
+            return 0;
+        }
+
+        case EXPORT_DONE: {
+            if (pData) {
+                pData->exportInProgress = false;
+                bool success = (wParam != 0);
+                if (pData->pMainWindow) {
+                    pData->pMainWindow->ShowExportMessageDialog(
+                        UiStrings::Get(success ? IDS_EXPORT_SUCCESS : IDS_EXPORT_ERROR), success);
+                }
+                if (success) {
+                    pData->shouldClose = true;
+                    DestroyWindow(hwnd);
+                } else {
+                    InvalidateRect(hwnd, NULL, FALSE);
+                }
+            }
+            return 0;
+        }
+
         case WM_CLOSE:
+            // Không đóng giữa chừng export - thread export đang post về hwnd này
+            if (pData && pData->exportInProgress) {
+                return 0;
+            }
             if (pData) {
                 pData->shouldClose = true;
             }
             DestroyWindow(hwnd);
             return 0;
-            
+
         case WM_ERASEBKGND:
             return TRUE;
     }
@@ -480,6 +537,9 @@ void MainWindow::ShowExportDialog() {
     dlgData.isExportHover = false;
     dlgData.isCancelHover = false;
     dlgData.shouldClose = false;
+    dlgData.exportInProgress = false;
+    dlgData.progressFetched = 0;
+    dlgData.progressWritten = 0;
     
     // Create dialog window
     HINSTANCE hInst = hInstance_ ? hInstance_ : GetModuleHandle(NULL);
@@ -538,11 +598,13 @@ bool MainWindow::ExportCurrentConversation(const std::wstring& filePath, ExportF
     );
 }
 
-bool MainWindow::ExportAllConversations(const std::wstring& filePath, ExportFormat format) {
+bool MainWindow::ExportAllConversations(const std::wstring& filePath, ExportFormat format,
+                                        const ExportService::ProgressCallback& progress) {
     return ExportService::ExportAllConversations(
         httpClient_,
         filePath,
         format,
-        modelName_
+        modelName_,
+        progress
     );
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
 #include "../core/ExportService.h"
+#include "../core/GDIResourceManager.h"
 #include <string>
 
 // Export message dialog structure
@@ -54,36 +55,32 @@ LRESULT CALLBACK MainWindow::ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM w
             HBITMAP hbmMem = CreateCompatibleBitmap(hdc, clientRect.right, clientRect.bottom);
             HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
             
+            // Font/brush/pen lấy từ cache process-wide - không DeleteObject
+            GDIResourceManager& gdiCache = GDIResourceManager::Shared();
+
             // Fill dark background
-            HBRUSH bgBrush = CreateSolidBrush(RGB(16, 22, 40));
+            HBRUSH bgBrush = gdiCache.GetBrush(RGB(16, 22, 40));
             FillRect(hdcMem, &clientRect, bgBrush);
-            DeleteObject(bgBrush);
-            
+
             // Draw header
             RECT headerRect = {0, 0, clientRect.right, 40};
-            HBRUSH headerBrush = CreateSolidBrush(RGB(16, 22, 40));
-            FillRect(hdcMem, &headerRect, headerBrush);
-            DeleteObject(headerBrush);
-            
+            FillRect(hdcMem, &headerRect, bgBrush);
+
             // Draw title
             SetBkMode(hdcMem, TRANSPARENT);
             SetTextColor(hdcMem, RGB(232, 236, 255));
-            HFONT hTitleFont = CreateFontW(-20, 0, 0, 0, FW_SEMIBOLD, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hTitleFont = gdiCache.GetFont(-20, FW_SEMIBOLD, L"Segoe UI");
             HFONT hOldFont = (HFONT)SelectObject(hdcMem, hTitleFont);
             RECT titleRect = {20, 0, clientRect.right, 40};
             DrawTextW(hdcMem, UiStrings::Get(IDS_EXPORT_TITLE).c_str(), -1, &titleRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hTitleFont);
-            
+
             // Draw cyan line
-            HPEN headerPen = CreatePen(PS_SOLID, 1, RGB(74, 215, 255));
+            HPEN headerPen = gdiCache.GetPen(PS_SOLID, 1, RGB(74, 215, 255));
             HGDIOBJ oldPen = SelectObject(hdcMem, headerPen);
             MoveToEx(hdcMem, 0, headerRect.bottom - 1, NULL);
             LineTo(hdcMem, clientRect.right, headerRect.bottom - 1);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(headerPen);
             
             if (pData) {
                 // Draw icon (success = checkmark, error = X)
@@ -92,15 +89,15 @@ LRESULT CALLBACK MainWindow::ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM w
                 
                 if (pData->isSuccess) {
                     // Draw checkmark circle
-                    HBRUSH iconBrush = CreateSolidBrush(iconColor);
-                    HPEN iconPen = CreatePen(PS_SOLID, 2, iconColor);
+                    HBRUSH iconBrush = gdiCache.GetBrush(iconColor);
+                    HPEN iconPen = gdiCache.GetPen(PS_SOLID, 2, iconColor);
                     HGDIOBJ oldIconBrush = SelectObject(hdcMem, iconBrush);
                     HGDIOBJ oldIconPen = SelectObject(hdcMem, iconPen);
                     Ellipse(hdcMem, pData->iconRect.left, pData->iconRect.top, 
                            pData->iconRect.right, pData->iconRect.bottom);
                     
                     // Draw checkmark
-                    HPEN checkmarkPen = CreatePen(PS_SOLID, 3, RGB(255, 255, 255));
+                    HPEN checkmarkPen = gdiCache.GetPen(PS_SOLID, 3, RGB(255, 255, 255));
                     SelectObject(hdcMem, checkmarkPen);
                     int centerX = (pData->iconRect.left + pData->iconRect.right) / 2;
                     int centerY = (pData->iconRect.top + pData->iconRect.bottom) / 2;
@@ -112,20 +109,17 @@ LRESULT CALLBACK MainWindow::ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM w
                     
                     SelectObject(hdcMem, oldIconBrush);
                     SelectObject(hdcMem, oldIconPen);
-                    DeleteObject(iconBrush);
-                    DeleteObject(iconPen);
-                    DeleteObject(checkmarkPen);
                 } else {
                     // Draw error X circle
-                    HBRUSH iconBrush = CreateSolidBrush(iconColor);
-                    HPEN iconPen = CreatePen(PS_SOLID, 2, iconColor);
+                    HBRUSH iconBrush = gdiCache.GetBrush(iconColor);
+                    HPEN iconPen = gdiCache.GetPen(PS_SOLID, 2, iconColor);
                     HGDIOBJ oldIconBrush = SelectObject(hdcMem, iconBrush);
                     HGDIOBJ oldIconPen = SelectObject(hdcMem, iconPen);
                     Ellipse(hdcMem, pData->iconRect.left, pData->iconRect.top, 
                            pData->iconRect.right, pData->iconRect.bottom);
                     
                     // Draw X
-                    HPEN xPen = CreatePen(PS_SOLID, 3, RGB(255, 255, 255));
+                    HPEN xPen = gdiCache.GetPen(PS_SOLID, 3, RGB(255, 255, 255));
                     SelectObject(hdcMem, xPen);
                     int centerX = (pData->iconRect.left + pData->iconRect.right) / 2;
                     int centerY = (pData->iconRect.top + pData->iconRect.bottom) / 2;
@@ -138,21 +132,15 @@ LRESULT CALLBACK MainWindow::ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM w
                     
                     SelectObject(hdcMem, oldIconBrush);
                     SelectObject(hdcMem, oldIconPen);
-                    DeleteObject(iconBrush);
-                    DeleteObject(iconPen);
-                    DeleteObject(xPen);
                 }
-                
+
                 // Draw message text
-                HFONT hMessageFont = CreateFontW(-16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                    DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                    CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+                HFONT hMessageFont = gdiCache.GetFont(-16, FW_NORMAL, L"Segoe UI");
                 hOldFont = (HFONT)SelectObject(hdcMem, hMessageFont);
                 SetTextColor(hdcMem, RGB(232, 236, 255));
-                DrawTextW(hdcMem, pData->message.c_str(), -1, &pData->messageRect, 
+                DrawTextW(hdcMem, pData->message.c_str(), -1, &pData->messageRect,
                          DT_LEFT | DT_VCENTER | DT_WORDBREAK);
                 SelectObject(hdcMem, hOldFont);
-                DeleteObject(hMessageFont);
                 
                 // Draw OK button
                 int radius = 8;
@@ -160,16 +148,14 @@ LRESULT CALLBACK MainWindow::ExportMessageDlgProc(HWND hwnd, UINT uMsg, WPARAM w
                 COLORREF okBorder = RGB(74, 215, 255);
                 COLORREF okText = pData->isOkHover ? RGB(0, 0, 0) : RGB(232, 236, 255);
                 
-                HBRUSH okBrush = CreateSolidBrush(okBg);
-                HPEN okPen = CreatePen(PS_SOLID, 1, okBorder);
+                HBRUSH okBrush = gdiCache.GetBrush(okBg);
+                HPEN okPen = gdiCache.GetPen(PS_SOLID, 1, okBorder);
                 HGDIOBJ oldBrush = SelectObject(hdcMem, okBrush);
                 oldPen = SelectObject(hdcMem, okPen);
-                RoundRect(hdcMem, pData->okRect.left, pData->okRect.top, 
+                RoundRect(hdcMem, pData->okRect.left, pData->okRect.top,
                          pData->okRect.right, pData->okRect.bottom, radius, radius);
                 SelectObject(hdcMem, oldBrush);
                 SelectObject(hdcMem, oldPen);
-                DeleteObject(okBrush);
-                DeleteObject(okPen);
                 
                 SetTextColor(hdcMem, okText);
                 hOldFont = (HFONT)SelectObject(hdcMem, hMessageFont);
@@ -43,7 +43,7 @@ MainWindow::MainWindow()
       modelName_(L"") {
     configPath_ = GetConfigPath();
     // Generate session ID
-    sessionId_ = "session_" + std::to_string(GetTickCount());
+    SetSessionId("session_" + std::to_string(GetTickCount()));
     
     // Read API key from .env file (searches multiple locations)
     std::string apiKey = ReadEnvFile("API_KEY");
@@ -71,7 +71,7 @@ MainWindow::~MainWindow() {
         KillTimer(hwnd_, copyFeedbackTimerId_);
     }
     // Smart pointers will automatically clean up GDI objects
-    // No manual DeleteObject needed
+    // No manual DeleteObject needed (renderBackend_ tự giải phóng backbuffer)
     if (healthCheckTimerId_ && hwnd_) {
         KillTimer(hwnd_, healthCheckTimerId_);
     }
@@ -110,16 +110,27 @@ void MainWindow::OnCommand(WPARAM wParam) {
             break;
         case 1004: // New conversation button
             if (HIWORD(wParam) == BN_CLICKED) {
+                // Hủy request đang bay của session cũ (nếu có)
+                httpClient_.cancelPendingRequests();
+                sendRequestId_++;
+
                 // Tạo session mới và reset UI
-                sessionId_ = "session_" + std::to_string(GetTickCount());
-                
-                // Kill animation timer if active
-                if (chatViewState_.animTimerId_ != 0 && hwnd_) {
-                    KillTimer(hwnd_, chatViewState_.animTimerId_);
+                SetSessionId("session_" + std::to_string(GetTickCount()));
+
+                // Dừng animation đang chạy (nếu có)
+                if (animDriver_) {
+                    animDriver_->Stop();
                 }
-                
+
                 // Reset chat view state
                 chatViewState_.Reset();
+                metadataBlobs_.Clear(); // Blob của các message vừa bị bỏ
+                // Index search mirror messages vừa clear - bỏ luôn folded
+                // text và kết quả cũ (ChatViewState::Reset không với tới
+                // member của MainWindow)
+                searchIndex_.Clear();
+                searchResults_.clear();
+                currentSearchIndex_ = -1;
 
                 // Clear hidden history and load conversations cho session mới (nếu backend dùng)
                 ClearEdit(hChatHistory_);
@@ -167,31 +178,116 @@ void MainWindow::SendChatMessage() {
     InvalidateRect(hwnd_, NULL, FALSE);
     UpdateWindow(hwnd_);
 
-    // Gửi message tới backend (blocking call)
-    std::string response = httpClient_.sendMessage(message, sessionId_);
+    // Khởi động animation đưa input xuống dưới ngay (không đợi response).
+    // Frame 60Hz đến từ AnimationDriver thay vì SetTimer 15ms (WM_TIMER
+    // coalesce dưới tải làm chuyển động giật cục).
+    chatViewState_.animStartY = chatViewState_.animCurrentY;
+    StartInputAnimation();
+
+    // Transcript server-side của session này sắp đổi -> bản prefetch (nếu có) đã cũ
+    transcriptPrefetchCache_.Erase(sessionId_);
+
+    // Gửi message tới backend trên worker thread; kết quả về qua WM_APP SEND_COMPLETE
+    // để UI thread (input, scroll, sidebar) không bị đóng băng trong lúc LLM trả lời.
+    sendRequestId_++;
+    if (enableStreamingResponses_) {
+        // Streaming mode: mỗi token về qua STREAM_DELTA và được vẽ ngay,
+        // thay vì đợi toàn bộ response (xem HttpClient::sendMessageStreamAsync).
+        httpClient_.sendMessageStreamAsync(message, hwnd_,
+                                           UiConstants::Messages::STREAM_DELTA,
+                                           UiConstants::Messages::STREAM_DONE,
+                                           sendRequestId_);
+    } else {
+        httpClient_.sendMessageAsync(message, sessionId_, hwnd_,
+                                     UiConstants::Messages::SEND_COMPLETE, sendRequestId_);
+    }
+}
+
+void MainWindow::OnStreamDelta(WPARAM requestId, std::string* deltaPtr) {
+    std::unique_ptr<std::string> owned(deltaPtr);
+
+    if (requestId != sendRequestId_ || !owned || chatViewState_.messages.empty()) {
+        return;
+    }
+
+    ChatMessage& lastMsg = chatViewState_.messages.back();
+    if (lastMsg.type != MessageType::AI) {
+        // Token đầu tiên: biến bubble "đang trả lời" thành bubble AI rỗng
+        lastMsg.text.clear();
+        lastMsg.isUser = false;
+        lastMsg.type = MessageType::AI;
+    }
+    lastMsg.text += Utf8ToWide(*owned);
+
+    InvalidateRect(hwnd_, NULL, FALSE);
+}
+
+void MainWindow::OnStreamComplete(WPARAM requestId, std::string* errorPtr) {
+    std::unique_ptr<std::string> owned(errorPtr);
+
+    if (requestId != sendRequestId_ || !owned || chatViewState_.messages.empty()) {
+        return;
+    }
+
+    ChatMessage& lastMsg = chatViewState_.messages.back();
+
+    if (!owned->empty()) {
+        // Stream kết thúc vì lỗi -> thay bubble bằng thông báo lỗi thân thiện
+        ErrorInfo error(ErrorCategory::Network, ErrorSeverity::Error, *owned);
+        error.context = "MainWindow::OnStreamComplete";
+        error.technicalDetails = *owned;
+        ErrorHandler::GetInstance().LogError(error);
+
+        lastMsg.text = ErrorHandler::GetInstance().GetUserFriendlyMessage(error);
+        lastMsg.isUser = false;
+        lastMsg.type = MessageType::Error;
+        lastMsg.metadata.rawJsonBlob = metadataBlobs_.Put(*owned);
+    } else if (lastMsg.type != MessageType::AI) {
+        // Stream done mà không có token nào
+        lastMsg.text = UiStrings::Get(IDS_BACKEND_NO_CONTENT);
+        lastMsg.isUser = false;
+        lastMsg.type = MessageType::AI;
+    }
+    lastMsg.timestamp = GetCurrentTimeW();
+    chatViewState_.InvalidateLayout(chatViewState_.messages.size() - 1);
+
+    // Không RefreshConversations: endpoint streaming hiện không lưu conversation
+    InvalidateRect(hwnd_, NULL, FALSE);
+}
+
+void MainWindow::OnSendMessageComplete(WPARAM requestId, std::string* responsePtr) {
+    // Receiver sở hữu chuỗi response do worker thread cấp phát
+    std::unique_ptr<std::string> owned(responsePtr);
+
+    // Request cũ (user đã bắt đầu session mới / gửi message khác) -> bỏ qua
+    if (requestId != sendRequestId_ || !owned) {
+        return;
+    }
+
+    const std::string& response = *owned;
 
     // Chuẩn bị text hiển thị cho AI / lỗi
     std::wstring aiText;
     bool isError = false;
     MessageMetadata metadata;
-    
+
     if (!response.empty() && response.rfind("Error:", 0) == 0) {
         isError = true;
-        metadata.rawJson = response;
-        
+        metadata.rawJsonBlob = metadataBlobs_.Put(response);
+
         // Use ErrorHandler to get user-friendly message
         ErrorInfo error(ErrorCategory::Network, ErrorSeverity::Error, response);
-        error.context = "MainWindow::SendChatMessage";
+        error.context = "MainWindow::OnSendMessageComplete";
         error.technicalDetails = response;
         ErrorHandler::GetInstance().LogError(error);
-        
+
         aiText = ErrorHandler::GetInstance().GetUserFriendlyMessage(error);
     } else {
         aiText = Utf8ToWide(response);
         if (aiText.empty()) {
             aiText = UiStrings::Get(IDS_BACKEND_NO_CONTENT);
         }
-        metadata.rawJson = response;
+        metadata.rawJsonBlob = metadataBlobs_.Put(response);
     }
 
     // Ghi đè bubble "đang trả lời" bằng nội dung thật
@@ -202,6 +298,8 @@ void MainWindow::SendChatMessage() {
         lastMsg.type = isError ? MessageType::Error : MessageType::AI;
         lastMsg.timestamp = GetCurrentTimeW();
         lastMsg.metadata = metadata;
+        // Text và type đổi -> layout cache của bubble này phải đo lại
+        chatViewState_.InvalidateLayout(chatViewState_.messages.size() - 1);
     } else {
         // Fallback (không nên xảy ra)
         if (isError) {
@@ -211,19 +309,18 @@ void MainWindow::SendChatMessage() {
         }
     }
 
-    // Sau khi đã có messages, khởi động animation đưa input xuống dưới
-    chatViewState_.animStartY = chatViewState_.animCurrentY;
-    // Target sẽ được tính trong OnSize dựa trên windowHeight_; tạm cập nhật
-    chatViewState_.isAnimating = true;
-    if (chatViewState_.animTimerId_ != 0) {
-        KillTimer(hwnd_, chatViewState_.animTimerId_);
-    }
-    chatViewState_.animTimerId_ = SetTimer(hwnd_, 1, 15, NULL); // 15ms ~ 60fps
-    
+    // Sidebar có thể có conversation mới sau khi gửi
+    RefreshConversations();
+
     // Redraw window to show new messages (no background erase to avoid flicker)
     InvalidateRect(hwnd_, NULL, FALSE);
 }
 
+void MainWindow::SetSessionId(const std::string& sessionId) {
+    sessionId_ = sessionId;
+    sessionIdW_ = Utf8ToWide(sessionId);
+}
+
 void MainWindow::LoadSettingsFromFile() {
     std::ifstream in(configPath_);
     if (!in.is_open()) return;
@@ -231,20 +328,35 @@ void MainWindow::LoadSettingsFromFile() {
     in.close();
     if (content.empty()) return;
     
-    std::string baseUrl = JsonParser::GetString(content, "baseUrl");
-    std::string apiKey = JsonParser::GetString(content, "apiKey");
+    // Parse config một lần rồi đọc từng field (ParsedDocument),
+    // thay vì parse lại cho mỗi GetString
+    JsonParser::ParsedDocument config(content);
+    std::string baseUrl = config.GetString("baseUrl");
+    std::string apiKey = config.GetString("apiKey");
     if (!baseUrl.empty()) {
         httpClient_.setBaseUrl(baseUrl);
     }
     if (!apiKey.empty()) {
         httpClient_.setApiKey(apiKey);
     }
-    
+
     // Load Ctrl+Enter setting
-    std::string ctrlEnterStr = JsonParser::GetString(content, "ctrlEnterToSend");
+    std::string ctrlEnterStr = config.GetString("ctrlEnterToSend");
     if (!ctrlEnterStr.empty()) {
         enableCtrlEnterToSend_ = (ctrlEnterStr == "true" || ctrlEnterStr == "1");
     }
+
+    // Load streaming mode setting (opt-in, chưa có UI toggle)
+    std::string streamingStr = config.GetString("streamingMode");
+    if (!streamingStr.empty()) {
+        enableStreamingResponses_ = (streamingStr == "true" || streamingStr == "1");
+    }
+
+    // Render backend: "d2d" thử Direct2D, fallback GDI (xem RenderBackend.h)
+    std::string backendStr = config.GetString("renderBackend");
+    if (!backendStr.empty()) {
+        renderBackendName_ = backendStr;
+    }
 }
 
 void MainWindow::SaveSettingsToFile(const std::string& baseUrl, const std::string& apiKey, bool ctrlEnterEnabled) {
@@ -259,13 +371,16 @@ void MainWindow::SaveSettingsToFile(const std::string& baseUrl, const std::strin
 }
 
 void MainWindow::UpdateModelNameFromHealth(const std::string& healthJson) {
+    // Parse một lần cho cả hai lookup (trước đây mỗi Get* parse lại từ đầu)
+    JsonParser::ParsedDocument health(healthJson);
+
     // Model name is nested in "llm.model" according to backend health endpoint
-    std::string model = JsonParser::GetNestedString(healthJson, "llm.model");
+    std::string model = health.GetNestedString("llm.model");
     if (!model.empty()) {
         modelName_ = Utf8ToWide(model);
     } else {
         // Fallback: try top-level "model" field (for backward compatibility)
-        model = JsonParser::GetString(healthJson, "model");
+        model = health.GetString("model");
         if (!model.empty()) {
             modelName_ = Utf8ToWide(model);
         } else {
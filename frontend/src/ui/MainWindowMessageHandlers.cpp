@@ -3,6 +3,7 @@
 #include "MainWindow.h"
 #include "UiConstants.h"
 #include "UiConfig.h"
+#include "../core/PerfMetrics.h"
 
 // Message handling functions extracted from MainWindow.cpp
 // This file handles window messages and delegates to appropriate handlers
@@ -59,6 +60,19 @@ void MainWindow::HandleChatMouseWheel(WPARAM wParam) {
     chatViewState_.scrollOffset -= step;
     if (chatViewState_.scrollOffset < 0) chatViewState_.scrollOffset = 0;
 
+    // Clamp ngay tại đây bằng tổng chiều cao từ prefix-sum (O(1)) để không
+    // overscroll ra vùng trống rồi chờ WM_PAINT kéo về
+    {
+        int inputHeight = 60;
+        int marginBottom = 20;
+        int messageAreaTop = theme_.headerHeight + (searchVisible_ ? 50 : 20);
+        int messageAreaBottom = windowHeight_ - inputHeight - marginBottom;
+        int availableHeight = messageAreaBottom - messageAreaTop;
+        int maxScroll = chatViewState_.TotalMessagesHeight() - availableHeight;
+        if (maxScroll < 0) maxScroll = 0;
+        if (chatViewState_.scrollOffset > maxScroll) chatViewState_.scrollOffset = maxScroll;
+    }
+
     // User is manually scrolling; stop auto-pinning to bottom
     chatViewState_.autoScrollToBottom = false;
 
@@ -100,59 +114,69 @@ void MainWindow::HandleTimer(WPARAM wParam) {
         return;
     }
     
-    if (wParam == Animation::TIMER_ID_INPUT && chatViewState_.isAnimating) {
-        // Animate input Y toward target with smooth easing interpolation
-        int remaining = chatViewState_.animTargetY - chatViewState_.animCurrentY;
-        if (remaining != 0) {
-            // Smooth ease-in-out interpolation: t^2 * (3 - 2*t) for smooth acceleration/deceleration
-            // Calculate progress: 0.0 to 1.0
-            int totalDistance = chatViewState_.animTargetY - chatViewState_.animStartY;
-            if (totalDistance == 0) {
-                chatViewState_.animCurrentY = chatViewState_.animTargetY;
-                chatViewState_.isAnimating = false;
-                if (chatViewState_.animTimerId_ != 0) {
-                    KillTimer(hwnd_, chatViewState_.animTimerId_);
-                    chatViewState_.animTimerId_ = 0;
-                }
-                OnSize();
-                return;
-            }
-            
-            float progress = static_cast<float>(chatViewState_.animCurrentY - chatViewState_.animStartY) / static_cast<float>(totalDistance);
-            // Clamp progress to [0, 1]
-            if (progress < 0.0f) progress = 0.0f;
-            if (progress > 1.0f) progress = 1.0f;
-            
-            // Smoothstep interpolation: t^2 * (3 - 2*t)
-            float smoothProgress = progress * progress * (3.0f - 2.0f * progress);
-            
-            // Calculate new position
-            int newY = chatViewState_.animStartY + static_cast<int>(smoothProgress * totalDistance);
-            
-            // Ensure we don't overshoot
-            if ((totalDistance > 0 && newY >= chatViewState_.animTargetY) ||
-                (totalDistance < 0 && newY <= chatViewState_.animTargetY)) {
-                chatViewState_.animCurrentY = chatViewState_.animTargetY;
-                chatViewState_.isAnimating = false;
-                if (chatViewState_.animTimerId_ != 0) {
-                    KillTimer(hwnd_, chatViewState_.animTimerId_);
-                    chatViewState_.animTimerId_ = 0;
-                }
-            } else {
-                chatViewState_.animCurrentY = newY;
-            }
-            
-            // Re-layout controls at new position
-            OnSize();
-        }
-        return;
-    }
-    
     if (wParam == Animation::TIMER_ID_HEALTH_CHECK) {
         // Health check timer
         CheckHealthStatus();
         return;
     }
+
+    if (wParam == Animation::TIMER_ID_HOVER_PREFETCH) {
+        // Hover đã đứng yên đủ lâu - timer một nhịp, bắn prefetch rồi thôi
+        KillTimer(hwnd_, Animation::TIMER_ID_HOVER_PREFETCH);
+        StartHoverPrefetch();
+        return;
+    }
+}
+
+void MainWindow::StartInputAnimation() {
+    using namespace UiConstants;
+
+    chatViewState_.isAnimating = true;
+    chatViewState_.animElapsedMs = 0.0;
+
+    // Chốt target (bottomY) ngay để frame đầu tiên đã có quãng đường đúng
+    OnSize();
+
+    if (!animDriver_) {
+        animDriver_ = std::make_unique<AnimationDriver>(hwnd_, Messages::ANIM_FRAME);
+    }
+    animDriver_->Start();
+}
+
+// Một frame từ AnimationDriver. Nội suy theo delta time thực (microseconds)
+// nên tốc độ animation không đổi dù frame bị coalesce khi UI bận.
+void MainWindow::OnAnimationFrame(WPARAM dtMicros) {
+    using namespace UiConstants;
+
+    if (!chatViewState_.isAnimating) {
+        // Hiệu ứng đã kết thúc/bị hủy giữa chừng - tắt pump
+        if (animDriver_) {
+            animDriver_->Stop();
+        }
+        return;
+    }
+
+    chatViewState_.animElapsedMs += (double)dtMicros / 1000.0;
+
+    int totalDistance = chatViewState_.animTargetY - chatViewState_.animStartY;
+    double progress = chatViewState_.animElapsedMs / Animation::INPUT_ANIM_DURATION_MS;
+
+    if (totalDistance == 0 || progress >= 1.0) {
+        chatViewState_.animCurrentY = chatViewState_.animTargetY;
+        chatViewState_.isAnimating = false;
+        if (animDriver_) {
+            animDriver_->Stop();
+        }
+    } else {
+        // Smoothstep interpolation: t^2 * (3 - 2*t)
+        float t = (float)progress;
+        float smoothProgress = t * t * (3.0f - 2.0f * t);
+        chatViewState_.animCurrentY =
+            chatViewState_.animStartY + (int)(smoothProgress * (float)totalDistance + 0.5f);
+    }
+
+    // Re-layout controls at new position
+    OnSize();
 }
 
 // Handle keyboard shortcuts
@@ -186,6 +210,19 @@ void MainWindow::HandleKeyDown(WPARAM wParam) {
         return;
     }
     
+    if (wParam == 'P' && (GetKeyState(VK_CONTROL) & 0x8000) && (GetKeyState(VK_SHIFT) & 0x8000)) {
+        // Ctrl+Shift+P -> toggle perf HUD overlay
+        perfHudVisible_ = !perfHudVisible_;
+        InvalidateRect(hwnd_, NULL, FALSE);
+        return;
+    }
+
+    if (wParam == 'D' && (GetKeyState(VK_CONTROL) & 0x8000) && (GetKeyState(VK_SHIFT) & 0x8000)) {
+        // Ctrl+Shift+D -> dump perf metrics ra file cạnh log (thu thập field)
+        PerfMetrics::GetInstance().DumpToFile();
+        return;
+    }
+
     if (wParam == 'F' && (GetKeyState(VK_CONTROL) & 0x8000)) {
         // Ctrl+F -> toggle search bar
         if (searchVisible_) {
@@ -365,13 +402,19 @@ void MainWindow::HandleMouseMove(LPARAM lParam) {
             }
         }
         if (newHover != hoveredConversationIndex_) {
+            // Chỉ hai row bị đổi diện mạo - invalidate đúng hai rect đó
+            int oldHover = hoveredConversationIndex_;
             hoveredConversationIndex_ = newHover;
-            InvalidateRect(hwnd_, NULL, FALSE);
+            ScheduleHoverPrefetch();
+            InvalidateSidebarItem(oldHover);
+            InvalidateSidebarItem(newHover);
         }
     } else {
         if (hoveredConversationIndex_ != -1) {
+            int oldHover = hoveredConversationIndex_;
             hoveredConversationIndex_ = -1;
-            InvalidateRect(hwnd_, NULL, FALSE);
+            ScheduleHoverPrefetch();
+            InvalidateSidebarItem(oldHover);
         }
     }
     
@@ -388,22 +431,22 @@ void MainWindow::HandleMouseLeave() {
     hoveredMessageIndex_ = -1;
     hoveredCopyIconIndex_ = -1;
     
-    // Reset search button hover states
-    bool needInvalidate = false;
+    // Reset search button hover states (mỗi element tự invalidate rect của nó)
     if (isSearchPrevButtonHover_) {
         isSearchPrevButtonHover_ = false;
-        needInvalidate = true;
+        InvalidateRect(hwnd_, &searchPrevButtonRect_, FALSE);
     }
     if (isSearchNextButtonHover_) {
         isSearchNextButtonHover_ = false;
-        needInvalidate = true;
+        InvalidateRect(hwnd_, &searchNextButtonRect_, FALSE);
     }
     if (isSearchCloseButtonHover_) {
         isSearchCloseButtonHover_ = false;
-        needInvalidate = true;
+        InvalidateRect(hwnd_, &searchCloseButtonRect_, FALSE);
     }
-    
-    if (oldHovered != -1 || oldCopyHovered != -1 || needInvalidate) {
-        InvalidateRect(hwnd_, NULL, FALSE);
+
+    InvalidateMessageHover(oldHovered);
+    if (oldCopyHovered != oldHovered) {
+        InvalidateMessageHover(oldCopyHovered);
     }
 }
\ No newline at end of file
@@ -4,18 +4,57 @@
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
 #include "UiConstants.h"
+#include "../core/PerfMetrics.h"
 #include <string>
 
 // Rendering functions split from MainWindowUI.cpp
 
-namespace {
-    // Local UTF-8 -> UTF-16 converter for rendering sessionId_
-    std::wstring Utf8ToWideLocal(const std::string& str) {
-        return Utf8ToWide(str);
+void MainWindow::EnsureStaticLayers(HDC hdcWindow, const RECT& clientRect) {
+    using namespace UiConstants;
+    int width = clientRect.right - clientRect.left;
+    int height = clientRect.bottom - clientRect.top;
+
+    // Grid layer: nền đen + lưới, phủ cả client area (reset trong OnSize)
+    if (!gridLayer_ && width > 0 && height > 0) {
+        gridLayer_ = gdiManager_->CreateLayer(hdcWindow, width, height);
+        if (gridLayer_) {
+            HDC layerDC = gridLayer_->Dc();
+            RECT layerRect = {0, 0, width, height};
+            FillRect(layerDC, &layerRect, hDarkBrush_->Get());
+
+            auto gridPen = gdiManager_->CreatePen(PS_SOLID, 1, theme_.colorGrid);
+            HPEN oldPen = (HPEN)SelectObject(layerDC, gridPen->Get());
+            for (int x = Grid::START_X; x < width; x += Grid::SPACING_X) {
+                MoveToEx(layerDC, x, 0, NULL);
+                LineTo(layerDC, x, height);
+            }
+            for (int y = Grid::START_Y; y < height; y += Grid::SPACING_Y) {
+                MoveToEx(layerDC, 0, y, NULL);
+                LineTo(layerDC, width, y);
+            }
+            SelectObject(layerDC, oldPen);
+        }
+    }
+
+    // Orb layer: kích thước cố định, chỉ render đúng một lần
+    if (!orbLayer_) {
+        int orbSize = 260;
+        orbLayer_ = gdiManager_->CreateLayer(hdcWindow, orbSize, orbSize);
+        if (orbLayer_) {
+            HDC layerDC = orbLayer_->Dc();
+            RECT orbRect = {0, 0, orbSize, orbSize};
+            auto orbBg = gdiManager_->CreateSolidBrush(RGB(0, 0, 0));
+            FillRect(layerDC, &orbRect, orbBg->Get());
+            auto orbFill = gdiManager_->CreateSolidBrush(RGB(40, 120, 255));
+            HBRUSH oldBrush = (HBRUSH)SelectObject(layerDC, orbFill->Get());
+            Ellipse(layerDC, 0, 0, orbSize, orbSize);
+            SelectObject(layerDC, oldBrush);
+        }
     }
 }
 
 void MainWindow::OnPaint() {
+    PerfMetrics::ScopedTimer frameTimer("paint.frame");
     PAINTSTRUCT ps;
     HDC hdcWindow = BeginPaint(hwnd_, &ps);
 
@@ -25,52 +64,60 @@ void MainWindow::OnPaint() {
     int width = clientRect.right - clientRect.left;
     int height = clientRect.bottom - clientRect.top;
 
-    HDC hdcMem = CreateCompatibleDC(hdcWindow);
-    HBITMAP hbmMem = CreateCompatibleBitmap(hdcWindow, width, height);
-    HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
+    // Backbuffer + present đi qua RenderBackend (GDI hoặc Direct2D theo
+    // config); tạo lazy vì cần hwnd_ và DC của window
+    if (!renderBackend_) {
+        renderBackend_ = RenderBackend::Create(renderBackendName_, hwnd_);
+    }
+    bool fullRedraw = false;
+    HDC hdcMem = renderBackend_->BeginFrame(hdcWindow, width, height, fullRedraw);
+    if (!hdcMem) {
+        EndPaint(hwnd_, &ps);
+        return;
+    }
+
+    // Buffer mới/resize/device lost chưa có nội dung frame trước -> vẽ toàn
+    // bộ; còn lại chỉ vùng bị invalidate (ps.rcPaint)
+    RECT dirtyRect = fullRedraw ? clientRect : ps.rcPaint;
+    if (dirtyRect.right <= dirtyRect.left || dirtyRect.bottom <= dirtyRect.top) {
+        // Frame đã Begin thì phải End dù không vẽ gì: Direct2D backend đang
+        // giữ BeginDraw + interop GetDC mở, bỏ ngang sẽ làm frame kế tiếp
+        // BeginDraw lồng nhau và EndDraw fail D2DERR_WRONG_STATE. Rect rỗng
+        // nên present là no-op (GDI BitBlt 0 pixel).
+        renderBackend_->EndFrame(hdcWindow, dirtyRect);
+        EndPaint(hwnd_, &ps);
+        return;
+    }
+
+    // Clip mọi draw call phía dưới vào vùng dirty: hover highlight chỉ tốn
+    // phần bubble bị đổi thay vì compose lại cả frame
+    int savedDC = SaveDC(hdcMem);
+    IntersectClipRect(hdcMem, dirtyRect.left, dirtyRect.top, dirtyRect.right, dirtyRect.bottom);
 
     HBRUSH oldBrush = nullptr;
     HPEN oldPen = nullptr;
 
-    // Fill background with solid black (darker look) - use cached brush
-    FillRect(hdcMem, &clientRect, hDarkBrush_->Get());
+    // Nền + grid + orb là layer tĩnh vẽ sẵn (EnsureStaticLayers),
+    // mỗi frame chỉ còn composite
+    EnsureStaticLayers(hdcWindow, clientRect);
 
-    // Overlay subtle grid - use resource manager
-    using namespace UiConstants;
-    auto gridPen = gdiManager_->CreatePen(PS_SOLID, 1, theme_.colorGrid);
-    oldPen = (HPEN)SelectObject(hdcMem, gridPen->Get());
-    for (int x = Grid::START_X; x < clientRect.right; x += Grid::SPACING_X) {
-        MoveToEx(hdcMem, x, 0, NULL);
-        LineTo(hdcMem, x, clientRect.bottom);
-    }
-    for (int y = Grid::START_Y; y < clientRect.bottom; y += Grid::SPACING_Y) {
-        MoveToEx(hdcMem, 0, y, NULL);
-        LineTo(hdcMem, clientRect.right, y);
+    if (gridLayer_) {
+        BitBlt(hdcMem, 0, 0, width, height, gridLayer_->Dc(), 0, 0, SRCCOPY);
+    } else {
+        // Fallback khi không cấp phát được layer
+        FillRect(hdcMem, &clientRect, hDarkBrush_->Get());
     }
-    SelectObject(hdcMem, oldPen);
-    // gridPen automatically cleaned up by smart pointer
 
     // Glowing orb (soft circle)
     int orbSize = 260;
     int orbX = clientRect.right - orbSize - 80;
     int orbY = 80;
-    BLENDFUNCTION bf = {AC_SRC_OVER, 0, 30, 0};
-    HDC orbDC = CreateCompatibleDC(hdcMem);
-    HBITMAP orbBmp = CreateCompatibleBitmap(hdcMem, orbSize, orbSize);
-    HBITMAP oldBmp = (HBITMAP)SelectObject(orbDC, orbBmp);
-    RECT orbRect = {0, 0, orbSize, orbSize};
-    HBRUSH orbBg = CreateSolidBrush(RGB(0,0,0));
-    FillRect(orbDC, &orbRect, orbBg);
-    DeleteObject(orbBg);
-    HBRUSH orbFill = CreateSolidBrush(RGB(40, 120, 255));
-    SelectObject(orbDC, orbFill);
-    Ellipse(orbDC, 0, 0, orbSize, orbSize);
-    AlphaBlend(hdcMem, orbX, orbY, orbSize, orbSize, orbDC, 0, 0, orbSize, orbSize, bf);
-    SelectObject(orbDC, oldBmp);
-    DeleteObject(orbFill);
-    DeleteObject(orbBmp);
-    DeleteDC(orbDC);
-    
+    if (orbLayer_) {
+        BLENDFUNCTION bf = {AC_SRC_OVER, 0, 30, 0};
+        AlphaBlend(hdcMem, orbX, orbY, orbSize, orbSize,
+                   orbLayer_->Dc(), 0, 0, orbSize, orbSize, bf);
+    }
+
     // Header bar
     int headerH = theme_.headerHeight;
     RECT headerRect = {clientRect.left, clientRect.top, clientRect.right, clientRect.top + headerH};
@@ -109,7 +156,8 @@ void MainWindow::OnPaint() {
     
     // Session ID text đặt giữa badge và icon settings + model name
     std::wstring sessionLabel = UiStrings::Get(IDS_SESSION_LABEL);
-    std::wstring sessionIdW = Utf8ToWideLocal(sessionId_);
+    // Bản wide đã cache khi session đổi (SetSessionId) - không convert mỗi frame
+    std::wstring sessionIdW = sessionIdW_;
     if (sessionIdW.length() > 16) {
         sessionIdW = L"..." + sessionIdW.substr(sessionIdW.length() - 13);
     }
@@ -186,17 +234,64 @@ void MainWindow::OnPaint() {
     // Draw input field
     DrawInputField(hdcMem);
 
-    // Blit the composed frame in one go
-    BitBlt(hdcWindow, 0, 0, width, height, hdcMem, 0, 0, SRCCOPY);
+    // Debug HUD đè lên mọi thứ (giá trị chỉ tươi trong vùng dirty - đủ
+    // cho mục đích debug, toggle thì invalidate cả window)
+    if (perfHudVisible_) {
+        DrawPerfHud(hdcMem);
+    }
+
+    RestoreDC(hdcMem, savedDC);
 
-    // Cleanup
-    SelectObject(hdcMem, hbmOld);
-    DeleteObject(hbmMem);
-    DeleteDC(hdcMem);
+    // Present vùng dirty (GDI: BitBlt; D2D: EndDraw do GPU composite)
+    renderBackend_->EndFrame(hdcWindow, dirtyRect);
 
     EndPaint(hwnd_, &ps);
 }
 
+void MainWindow::DrawPerfHud(HDC hdc) {
+    auto snapshots = PerfMetrics::GetInstance().GetSnapshots();
+
+    const int lineH = 16;
+    const int padding = 10;
+    const int hudWidth = 430;
+    int hudHeight = padding * 2 + lineH * (2 + (int)snapshots.size());
+    RECT hudRect = {
+        windowWidth_ - hudWidth - 16,
+        theme_.headerHeight + 12,
+        windowWidth_ - 16,
+        theme_.headerHeight + 12 + hudHeight
+    };
+
+    HBRUSH hudBrush = CreateSolidBrush(RGB(12, 16, 32));
+    FillRect(hdc, &hudRect, hudBrush);
+    DeleteObject(hudBrush);
+    FrameRect(hdc, &hudRect, (HBRUSH)GetStockObject(GRAY_BRUSH));
+
+    SetBkMode(hdc, TRANSPARENT);
+    SelectObject(hdc, hMetaFont_->Get());
+
+    int y = hudRect.top + padding;
+    RECT lineRect = {hudRect.left + padding, y, hudRect.right - padding, y + lineH};
+
+    SetTextColor(hdc, RGB(120, 190, 240));
+    DrawTextW(hdc, L"perf (ms)                 cnt    avg    p50    p95    p99", -1,
+              &lineRect, DT_LEFT | DT_SINGLELINE | DT_NOPREFIX);
+    OffsetRect(&lineRect, 0, lineH);
+
+    SetTextColor(hdc, RGB(232, 236, 255));
+    wchar_t line[160];
+    for (const auto& s : snapshots) {
+        swprintf(line, 160, L"%-24hs %5lld %6.1f %6.1f %6.1f %6.1f",
+                 s.name.c_str(), s.count, s.avgMs, s.p50Ms, s.p95Ms, s.p99Ms);
+        DrawTextW(hdc, line, -1, &lineRect, DT_LEFT | DT_SINGLELINE | DT_NOPREFIX);
+        OffsetRect(&lineRect, 0, lineH);
+    }
+
+    SetTextColor(hdc, RGB(154, 163, 195));
+    DrawTextW(hdc, L"Ctrl+Shift+P: hide   Ctrl+Shift+D: dump to file", -1,
+              &lineRect, DT_LEFT | DT_SINGLELINE | DT_NOPREFIX);
+}
+
 BOOL MainWindow::OnEraseBkgnd(HDC hdc) {
     // We paint the full background in OnPaint with double buffering,
     // so return TRUE here to prevent Windows from erasing the background
@@ -65,19 +65,26 @@ void MainWindow::DrawSidebar(HDC hdc) {
     
     // Use cached sidebar fonts
     
-    int currentY = startY - sidebarScrollOffset_;
-
     // Clip drawing to the list region so items never paint into header
     int savedDC = SaveDC(hdc);
     IntersectClipRect(hdc, sidebarRect.left, contentTop, sidebarRect.right, contentBottom);
-    
-    for (size_t i = 0; i < conversations_.size(); i++) {
-        if (currentY > contentBottom) break;
-        if (currentY + itemHeight < contentTop) {
-            currentY += itemHeight;
-            continue;
-        }
-        
+
+    // Virtualized: row height cố định nên index range nhìn thấy tính O(1)
+    // từ scroll offset - paint cost theo số row trên màn hình, không theo
+    // kích thước archive (10k session vẽ đúng ~chục row)
+    size_t firstVisible = (sidebarScrollOffset_ > 0)
+        ? static_cast<size_t>(sidebarScrollOffset_ / itemHeight)
+        : 0;
+    size_t endVisible = (sidebarScrollOffset_ + visibleHeight >= 0)
+        ? static_cast<size_t>((sidebarScrollOffset_ + visibleHeight) / itemHeight) + 1
+        : 0;
+    if (endVisible > conversations_.size()) {
+        endVisible = conversations_.size();
+    }
+
+    int currentY = startY - sidebarScrollOffset_ + static_cast<int>(firstVisible) * itemHeight;
+
+    for (size_t i = firstVisible; i < endVisible; i++) {
         RECT itemRect = {
             sidebarX + itemPaddingX,
             currentY,
@@ -138,6 +145,9 @@ void MainWindow::DrawSidebar(HDC hdc) {
             // Smart pointers automatically clean up
         }
         
+        // Format preview/timestamp lần đầu row này hiện ra (lazy)
+        EnsureConversationDisplay(conversations_[i]);
+
         // Preview text với màu sáng hơn khi selected
         SelectObject(hdc, hSidebarItemFont_->Get());
         SetTextColor(hdc, isSelected ? RGB(240, 245, 255)
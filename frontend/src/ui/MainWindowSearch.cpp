@@ -7,44 +7,10 @@
 #include <cwctype>
 #include <string>
 
-// Search functionality implementation
-
-// Case-insensitive string comparison helper
-bool CaseInsensitiveContains(const std::wstring& text, const std::wstring& query) {
-    if (query.empty()) return false;
-    if (text.length() < query.length()) return false;
-    
-    for (size_t i = 0; i <= text.length() - query.length(); ++i) {
-        bool match = true;
-        for (size_t j = 0; j < query.length(); ++j) {
-            if (towlower(text[i + j]) != towlower(query[j])) {
-                match = false;
-                break;
-            }
-        }
-        if (match) return true;
-    }
-    return false;
-}
-
-// Find all matches in text (returns pairs of start and end positions)
-std::vector<std::pair<size_t, size_t>> MainWindow::FindTextMatches(const std::wstring& text, const std::wstring& query) {
-    std::vector<std::pair<size_t, size_t>> matches;
-    if (query.empty() || text.empty()) return matches;
-    
-    std::wstring lowerText = text;
-    std::wstring lowerQuery = query;
-    std::transform(lowerText.begin(), lowerText.end(), lowerText.begin(), towlower);
-    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), towlower);
-    
-    size_t pos = 0;
-    while ((pos = lowerText.find(lowerQuery, pos)) != std::wstring::npos) {
-        matches.push_back({pos, pos + query.length()});
-        pos += query.length();
-    }
-    
-    return matches;
-}
+// Search functionality implementation.
+// Matching chạy trên SearchIndex (src/core/SearchIndex.h): text của từng
+// message được case-fold đúng một lần khi thêm/đổi, query fold một lần mỗi
+// keystroke — không còn towlower trên toàn bộ transcript như trước.
 
 // Show search bar
 void MainWindow::ShowSearchBar() {
@@ -163,13 +129,17 @@ void MainWindow::PerformSearch(const std::wstring& query) {
         return;
     }
     
-    // Search through all messages
+    // Đồng bộ index với transcript hiện tại (fold chỉ những message mới/đổi).
+    // Transcript bị thay (đổi session) -> rebuild từ đầu.
+    if (searchIndex_.Size() > chatViewState_.messages.size()) {
+        searchIndex_.Clear();
+    }
     for (size_t i = 0; i < chatViewState_.messages.size(); ++i) {
-        const auto& msg = chatViewState_.messages[i];
-        if (CaseInsensitiveContains(msg.text, query)) {
-            searchResults_.push_back(static_cast<int>(i));
-        }
+        searchIndex_.SyncEntry(i, chatViewState_.messages[i].text);
     }
+
+    searchQueryFolded_ = SearchIndex::FoldText(query);
+    searchResults_ = searchIndex_.FindMatchingEntries(searchQueryFolded_);
     
     // If we have results, navigate to first one
     if (!searchResults_.empty()) {
@@ -234,18 +204,16 @@ void MainWindow::ScrollToSearchResult(int messageIndex) {
     int messageAreaBottom = clientRect.bottom - inputHeight - marginBottom;
     int availableHeight = messageAreaBottom - messageAreaTop;
     
-    // Calculate total height up to target message
-    int totalHeight = 0;
-    int messageMarginY = theme_.messageMarginY;
-    int bubblePaddingY = 12;
-    
-    for (int i = 0; i < messageIndex; ++i) {
-        const auto& msg = chatViewState_.messages[i];
-        // Estimate message height (simplified)
-        int estimatedHeight = 60; // Default estimate
-        totalHeight += estimatedHeight + messageMarginY;
+    // Vị trí message lấy từ prefix-sum (chính xác, O(1)) thay vì
+    // ước lượng 60px/message như trước — kết quả search không còn lệch.
+    int totalHeight;
+    if (static_cast<size_t>(messageIndex) < chatViewState_.heightPrefix.size()) {
+        totalHeight = chatViewState_.MessageTop(static_cast<size_t>(messageIndex));
+    } else {
+        // Chưa paint lần nào (hiếm): fallback ước lượng cũ
+        totalHeight = messageIndex * (60 + theme_.messageMarginY);
     }
-    
+
     // Calculate scroll offset to center the message
     int targetScroll = totalHeight - (availableHeight / 2);
     if (targetScroll < 0) targetScroll = 0;
@@ -343,31 +311,17 @@ void MainWindow::DrawSearchButton(HDC hdc, const RECT& rect, const wchar_t* text
 }
 
 // Draw search highlight in text
-void MainWindow::DrawSearchHighlight(HDC hdc, const std::wstring& text, const RECT& textRect, HFONT hFont) {
+void MainWindow::DrawSearchHighlight(HDC hdc, size_t msgIdx, const std::wstring& text,
+                                     const RECT& textRect, HFONT hFont) {
     if (searchQuery_.empty() || text.empty()) return;
-    
-    // Get matches
-    auto matches = FindTextMatches(text, searchQuery_);
+
+    // Vị trí match lấy từ folded text đã cache trong index (cùng độ dài với text gốc)
+    auto matches = searchIndex_.FindMatchesIn(msgIdx, searchQueryFolded_);
     if (matches.empty()) return;
     
-    // Select font for text measurement
+    // Select font for highlight drawing
     HGDIOBJ oldFont = SelectObject(hdc, hFont);
-    
-    // Calculate character positions
-    std::vector<int> charXPositions;
-    charXPositions.reserve(text.length() + 1);
-    
-    int currentX = textRect.left;
-    charXPositions.push_back(currentX);
-    
-    for (size_t i = 0; i < text.length(); ++i) {
-        wchar_t ch = text[i];
-        SIZE charSize;
-        GetTextExtentPoint32W(hdc, &ch, 1, &charSize);
-        currentX += charSize.cx;
-        charXPositions.push_back(currentX);
-    }
-    
+
     // Draw highlights with a more visible color
     COLORREF highlightColor = RGB(255, 255, 100); // Bright yellow highlight
     HBRUSH highlightBrush = CreateSolidBrush(highlightColor);
@@ -377,10 +331,19 @@ void MainWindow::DrawSearchHighlight(HDC hdc, const std::wstring& text, const RE
     int oldBkMode = SetBkMode(hdc, OPAQUE);
     SetBkColor(hdc, highlightColor);
     
+    // Vị trí X của mỗi match = bề rộng prefix trước nó, đo qua cache memo
+    // của GDIResourceManager (trước đây GetTextExtentPoint32W từng ký tự
+    // trên toàn bộ text mỗi lần vẽ)
     for (const auto& match : matches) {
-        int startX = charXPositions[match.first];
-        int endX = charXPositions[match.second];
-        
+        int startX = textRect.left;
+        if (match.first > 0) {
+            startX += gdiManager_->MeasureText(hdc, hFont, text.substr(0, match.first),
+                                               0, DT_SINGLELINE).cx;
+        }
+        int endX = textRect.left +
+                   gdiManager_->MeasureText(hdc, hFont, text.substr(0, match.second),
+                                            0, DT_SINGLELINE).cx;
+
         // Draw highlight rectangle
         RECT highlightRect = {startX, textRect.top, endX, textRect.bottom};
         FillRect(hdc, &highlightRect, highlightBrush);
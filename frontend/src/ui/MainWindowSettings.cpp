@@ -3,6 +3,7 @@
 #include <dwmapi.h>
 #include "MainWindow.h"
 #include "MainWindowHelpers.h"
+#include "../core/GDIResourceManager.h"
 #include <string>
 
 // Settings dialog implementation
@@ -48,10 +49,8 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
                 WS_CHILD | WS_VISIBLE | WS_TABSTOP | ES_LEFT | ES_PASSWORD,
                 22, 138, 456, 28, hwnd, (HMENU)1002, hInst, NULL);
             
-            // Set fonts
-            HFONT hDlgFont = CreateFontW(-16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            // Set fonts (cache sở hữu handle - edit control chỉ mượn)
+            HFONT hDlgFont = GDIResourceManager::Shared().GetFont(-16, FW_NORMAL, L"Segoe UI");
             SendMessageW(pData->hUrlEdit, WM_SETFONT, (WPARAM)hDlgFont, TRUE);
             SendMessageW(pData->hKeyEdit, WM_SETFONT, (WPARAM)hDlgFont, TRUE);
             
@@ -94,41 +93,36 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             HBITMAP hbmMem = CreateCompatibleBitmap(hdc, clientRect.right, clientRect.bottom);
             HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, hbmMem);
             
+            // Mọi font/brush/pen của dialog đi qua cache process-wide:
+            // handle do cache sở hữu, tuyệt đối không DeleteObject ở đây
+            GDIResourceManager& gdiCache = GDIResourceManager::Shared();
+
             // Fill dark background
-            HBRUSH bgBrush = CreateSolidBrush(RGB(16, 22, 40));
+            HBRUSH bgBrush = gdiCache.GetBrush(RGB(16, 22, 40));
             FillRect(hdcMem, &clientRect, bgBrush);
-            DeleteObject(bgBrush);
-            
+
             // Draw header with cyan line
             RECT headerRect = {0, 0, clientRect.right, 40};
-            HBRUSH headerBrush = CreateSolidBrush(RGB(16, 22, 40));
-            FillRect(hdcMem, &headerRect, headerBrush);
-            DeleteObject(headerBrush);
-            
+            FillRect(hdcMem, &headerRect, bgBrush);
+
             // Draw title first (before the line)
             SetBkMode(hdcMem, TRANSPARENT);
             SetTextColor(hdcMem, RGB(232, 236, 255));
-            HFONT hTitleFont = CreateFontW(-20, 0, 0, 0, FW_SEMIBOLD, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hTitleFont = gdiCache.GetFont(-20, FW_SEMIBOLD, L"Segoe UI");
             HFONT hOldFont = (HFONT)SelectObject(hdcMem, hTitleFont);
             RECT titleRect = {20, 0, clientRect.right, 40};
             DrawTextW(hdcMem, UiStrings::Get(IDS_SETTINGS_TITLE).c_str(), -1, &titleRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hTitleFont);
-            
+
             // Draw cyan line at the bottom of header (after title)
-            HPEN headerPen = CreatePen(PS_SOLID, 1, RGB(74, 215, 255));
+            HPEN headerPen = gdiCache.GetPen(PS_SOLID, 1, RGB(74, 215, 255));
             HGDIOBJ oldPen = SelectObject(hdcMem, headerPen);
             MoveToEx(hdcMem, 0, headerRect.bottom - 1, NULL);
             LineTo(hdcMem, clientRect.right, headerRect.bottom - 1);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(headerPen);
-            
+
             // Draw labels (below the header line)
-            HFONT hLabelFont = CreateFontW(-16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+            HFONT hLabelFont = gdiCache.GetFont(-16, FW_NORMAL, L"Segoe UI");
             hOldFont = (HFONT)SelectObject(hdcMem, hLabelFont);
             SetTextColor(hdcMem, RGB(200, 210, 230));
             
@@ -164,8 +158,8 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
                 
                 // Draw checkbox box with rounded corners
                 int radius = 4;
-                HBRUSH checkboxBrush = CreateSolidBrush(checkboxBg);
-                HPEN checkboxPen = CreatePen(PS_SOLID, 1, checkboxBorder);
+                HBRUSH checkboxBrush = gdiCache.GetBrush(checkboxBg);
+                HPEN checkboxPen = gdiCache.GetPen(PS_SOLID, 1, checkboxBorder);
                 HGDIOBJ oldCheckboxBrush = SelectObject(hdcMem, checkboxBrush);
                 HGDIOBJ oldCheckboxPen = SelectObject(hdcMem, checkboxPen);
                 RoundRect(hdcMem, checkboxBox.left, checkboxBox.top, checkboxBox.right, checkboxBox.bottom, radius, radius);
@@ -173,7 +167,7 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
                 // Draw checkmark if checked
                 if (pData->isCtrlEnterChecked) {
                     // Draw checkmark with white color for better contrast on cyan background
-                    HPEN checkmarkPen = CreatePen(PS_SOLID, 2, RGB(255, 255, 255));
+                    HPEN checkmarkPen = gdiCache.GetPen(PS_SOLID, 2, RGB(255, 255, 255));
                     HGDIOBJ oldCheckmarkPen = SelectObject(hdcMem, checkmarkPen);
                     
                     // Draw checkmark (V shape) - centered and properly sized
@@ -190,13 +184,10 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
                     LineTo(hdcMem, checkX + checkSize, checkY - 3);
                     
                     SelectObject(hdcMem, oldCheckmarkPen);
-                    DeleteObject(checkmarkPen);
                 }
-                
+
                 SelectObject(hdcMem, oldCheckboxBrush);
                 SelectObject(hdcMem, oldCheckboxPen);
-                DeleteObject(checkboxBrush);
-                DeleteObject(checkboxPen);
                 
                 // Draw checkbox label text
                 SetTextColor(hdcMem, RGB(232, 236, 255));
@@ -206,8 +197,7 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             }
             
             SelectObject(hdcMem, hOldFont);
-            DeleteObject(hLabelFont);
-            
+
             // Draw input field borders (similar to main input field)
             if (pData && pData->hUrlEdit && pData->hKeyEdit) {
                 RECT urlRect, keyRect;
@@ -233,16 +223,14 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
                 keyRect.bottom = pt4.y + 2;
                 
                 // Outer border (cyan)
-                HPEN borderPen = CreatePen(PS_SOLID, 2, RGB(74, 215, 255));
-                HBRUSH borderBrush = CreateSolidBrush(RGB(25, 36, 64));
+                HPEN borderPen = gdiCache.GetPen(PS_SOLID, 2, RGB(74, 215, 255));
+                HBRUSH borderBrush = gdiCache.GetBrush(RGB(25, 36, 64));
                 HGDIOBJ oldBorderPen = SelectObject(hdcMem, borderPen);
                 HGDIOBJ oldBorderBrush = SelectObject(hdcMem, borderBrush);
                 RoundRect(hdcMem, urlRect.left, urlRect.top, urlRect.right, urlRect.bottom, 8, 8);
                 RoundRect(hdcMem, keyRect.left, keyRect.top, keyRect.right, keyRect.bottom, 8, 8);
                 SelectObject(hdcMem, oldBorderBrush);
                 SelectObject(hdcMem, oldBorderPen);
-                DeleteObject(borderBrush);
-                DeleteObject(borderPen);
             }
             
             // Draw buttons
@@ -251,15 +239,13 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             COLORREF okBorder = RGB(74, 215, 255);
             COLORREF okText = pData->isOkHover ? RGB(0, 0, 0) : RGB(232, 236, 255);
             
-            HBRUSH okBrush = CreateSolidBrush(okBg);
-            HPEN okPen = CreatePen(PS_SOLID, 1, okBorder);
+            HBRUSH okBrush = gdiCache.GetBrush(okBg);
+            HPEN okPen = gdiCache.GetPen(PS_SOLID, 1, okBorder);
             HGDIOBJ oldBrush = SelectObject(hdcMem, okBrush);
             oldPen = SelectObject(hdcMem, okPen);
             RoundRect(hdcMem, pData->okRect.left, pData->okRect.top, pData->okRect.right, pData->okRect.bottom, radius, radius);
             SelectObject(hdcMem, oldBrush);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(okBrush);
-            DeleteObject(okPen);
             
             SetTextColor(hdcMem, okText);
             hOldFont = (HFONT)SelectObject(hdcMem, hLabelFont);
@@ -269,15 +255,13 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             COLORREF cancelBorder = RGB(60, 90, 130);
             COLORREF cancelText = RGB(200, 210, 230);
             
-            HBRUSH cancelBrush = CreateSolidBrush(cancelBg);
-            HPEN cancelPen = CreatePen(PS_SOLID, 1, cancelBorder);
+            HBRUSH cancelBrush = gdiCache.GetBrush(cancelBg);
+            HPEN cancelPen = gdiCache.GetPen(PS_SOLID, 1, cancelBorder);
             oldBrush = SelectObject(hdcMem, cancelBrush);
             oldPen = SelectObject(hdcMem, cancelPen);
             RoundRect(hdcMem, pData->cancelRect.left, pData->cancelRect.top, pData->cancelRect.right, pData->cancelRect.bottom, radius, radius);
             SelectObject(hdcMem, oldBrush);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(cancelBrush);
-            DeleteObject(cancelPen);
             
             SetTextColor(hdcMem, cancelText);
             DrawTextW(hdcMem, UiStrings::Get(IDS_CANCEL_BUTTON).c_str(), -1, &pData->cancelRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
@@ -287,15 +271,13 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             COLORREF exportBorder = RGB(74, 215, 255);
             COLORREF exportText = pData->isExportHover ? RGB(0, 0, 0) : RGB(232, 236, 255);
             
-            HBRUSH exportBrush = CreateSolidBrush(exportBg);
-            HPEN exportPen = CreatePen(PS_SOLID, 1, exportBorder);
+            HBRUSH exportBrush = gdiCache.GetBrush(exportBg);
+            HPEN exportPen = gdiCache.GetPen(PS_SOLID, 1, exportBorder);
             oldBrush = SelectObject(hdcMem, exportBrush);
             oldPen = SelectObject(hdcMem, exportPen);
             RoundRect(hdcMem, pData->exportRect.left, pData->exportRect.top, pData->exportRect.right, pData->exportRect.bottom, radius, radius);
             SelectObject(hdcMem, oldBrush);
             SelectObject(hdcMem, oldPen);
-            DeleteObject(exportBrush);
-            DeleteObject(exportPen);
             
             SetTextColor(hdcMem, exportText);
             DrawTextW(hdcMem, L"Xuất", -1, &pData->exportRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
@@ -318,11 +300,7 @@ LRESULT CALLBACK MainWindow::SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam
             SetBkMode(hdc, TRANSPARENT);
             SetBkColor(hdc, RGB(18, 24, 42));
             SetTextColor(hdc, RGB(255, 255, 255));
-            static HBRUSH hEditBrush = NULL;
-            if (!hEditBrush) {
-                hEditBrush = CreateSolidBrush(RGB(18, 24, 42));
-            }
-            return (LRESULT)hEditBrush;
+            return (LRESULT)GDIResourceManager::Shared().GetBrush(RGB(18, 24, 42));
         }
         
         case WM_CTLCOLORSTATIC: {
@@ -5,8 +5,23 @@
 void MainWindow::OnSize() {
     RECT clientRect;
     GetClientRect(hwnd_, &clientRect);
-    windowWidth_ = clientRect.right - clientRect.left;
-    windowHeight_ = clientRect.bottom - clientRect.top;
+    int newWidth = clientRect.right - clientRect.left;
+    int newHeight = clientRect.bottom - clientRect.top;
+    // OnSize còn được gọi mỗi frame animation (OnAnimationFrame) chỉ để
+    // re-layout input; chỉ đập backbuffer khi client size thật sự đổi,
+    // không thì mỗi frame 16ms lại recreate + full redraw - mất sạch
+    // persistent backbuffer và dirty-rect path đúng lúc cần nhất
+    bool sizeChanged = (newWidth != windowWidth_ || newHeight != windowHeight_);
+    windowWidth_ = newWidth;
+    windowHeight_ = newHeight;
+
+    // Kích thước đổi -> backbuffer của backend và grid layer cũ sai size
+    if (sizeChanged) {
+        if (renderBackend_) {
+            renderBackend_->OnResize(windowWidth_, windowHeight_);
+        }
+        gridLayer_.reset(); // "Render once" chỉ đúng nếu không reset mỗi frame
+    }
 
     // Layout input:
     // - Khi chưa có message: input nằm giữa màn hình, ngay dưới dòng title
@@ -182,7 +197,11 @@ void MainWindow::OnCreate() {
     hSidebarMetaFont_ = gdiManager_->CreateFont(-13, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
         DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
         CLEARTYPE_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
-    
+
+    // Pre-warm cache GDI dùng chung cho các dialog (Settings/Export/ExitConfirm)
+    // để lần mở dialog đầu tiên không trả chi phí tạo font/brush/pen
+    GDIResourceManager::Shared().PrewarmCommonResources();
+
     RECT clientRect;
     GetClientRect(hwnd_, &clientRect);
     int width = clientRect.right - clientRect.left;
@@ -289,14 +308,27 @@ void MainWindow::OnCreate() {
         newSessionButtonRect_.bottom = newSessionButtonRect_.top + newBtnHeight;
     }
     
+    // Vẽ ngay dữ liệu lần chạy trước từ cache trên disk (nếu có);
+    // RefreshConversations ở delayed init sẽ đối chiếu với backend sau
+    LoadConversationCache();
+
     // Update window
     UpdateWindow(hwnd_);
-    
-    // Start health check timer (check every 10 seconds)
-    healthCheckTimerId_ = SetTimer(hwnd_, 2, 10000, NULL);
-    // Initial health check
+
+    // Initial health check (async). Timer ở đây chỉ là lịch tạm trong lúc đợi
+    // kết quả đầu tiên; OnHealthCheckComplete sẽ đặt lại interval theo trạng thái
+    // (online poll thưa, offline backoff lũy thừa).
+    healthCheckTimerId_ = SetTimer(hwnd_, UiConstants::Animation::TIMER_ID_HEALTH_CHECK,
+                                   UiConstants::Health::CHECKING_INTERVAL_MS, NULL);
     CheckHealthStatus();
-    
+
+    // Kênh long-poll: backend báo có conversation mới (instance khác gửi,
+    // backend tự tạo...) thay vì phải poll lại danh sách. Mốc id đã thấy
+    // được nâng trong FinishConversationsRefresh.
+    updateChannel_ = std::make_unique<UpdateChannel>(
+        httpClient_, hwnd_, UiConstants::Messages::CONVERSATIONS_CHANGED);
+    updateChannel_->NotifySeenId(newestConversationId_);
+
     // Delayed initialization
     PostMessage(hwnd_, WM_USER + 1, 0, 0);
 }
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "RenderBackend.h"
+#include "../core/ErrorHandler.h"
+#include <d2d1.h>
+
+// Hai implementation nằm gọn trong file này; bên ngoài chỉ thấy interface
+// RenderBackend và factory Create (xem RenderBackend.h).
+
+namespace {
+
+/**
+ * GdiRenderBackend - backbuffer CompatibleBitmap bền vững + BitBlt
+ * (đường render cũ của OnPaint, tách ra sau khi có abstraction)
+ */
+class GdiRenderBackend : public RenderBackend {
+public:
+    ~GdiRenderBackend() override {
+        Release();
+    }
+
+    void OnResize(int /*width*/, int /*height*/) override {
+        // Buffer sai size -> BeginFrame kế tiếp tạo lại
+        Release();
+    }
+
+    HDC BeginFrame(HDC hdcWindow, int width, int height, bool& outFullRedraw) override {
+        outFullRedraw = false;
+        if (width <= 0 || height <= 0) {
+            return NULL;
+        }
+        if (dc_ && width_ == width && height_ == height) {
+            return dc_; // Buffer hiện tại dùng lại được
+        }
+
+        Release();
+
+        dc_ = CreateCompatibleDC(hdcWindow);
+        if (!dc_) {
+            return NULL;
+        }
+        bitmap_ = CreateCompatibleBitmap(hdcWindow, width, height);
+        if (!bitmap_) {
+            DeleteDC(dc_);
+            dc_ = NULL;
+            return NULL;
+        }
+        oldBitmap_ = (HBITMAP)SelectObject(dc_, bitmap_);
+        width_ = width;
+        height_ = height;
+
+        outFullRedraw = true; // Buffer mới chưa có nội dung frame trước
+        return dc_;
+    }
+
+    void EndFrame(HDC hdcWindow, const RECT& dirtyRect) override {
+        if (!dc_) {
+            return;
+        }
+        BitBlt(hdcWindow, dirtyRect.left, dirtyRect.top,
+               dirtyRect.right - dirtyRect.left, dirtyRect.bottom - dirtyRect.top,
+               dc_, dirtyRect.left, dirtyRect.top, SRCCOPY);
+    }
+
+    const char* Name() const override { return "gdi"; }
+
+private:
+    void Release() {
+        if (dc_) {
+            if (oldBitmap_) {
+                SelectObject(dc_, oldBitmap_);
+                oldBitmap_ = NULL;
+            }
+            DeleteDC(dc_);
+            dc_ = NULL;
+        }
+        if (bitmap_) {
+            DeleteObject(bitmap_);
+            bitmap_ = NULL;
+        }
+        width_ = 0;
+        height_ = 0;
+    }
+
+    HDC dc_ = NULL;
+    HBITMAP bitmap_ = NULL;
+    HBITMAP oldBitmap_ = NULL;
+    int width_ = 0;
+    int height_ = 0;
+};
+
+/**
+ * D2DRenderBackend - ID2D1HwndRenderTarget GDI-compatible
+ *
+ * Draw code GDI vẽ vào target qua ID2D1GdiInteropRenderTarget
+ * (GetDC mode COPY giữ lại nội dung frame trước nên partial redraw vẫn
+ * hoạt động); EndDraw present bằng GPU thay vì BitBlt phần mềm.
+ * Device lost (D2DERR_RECREATE_TARGET) -> tạo lại target và ép full redraw.
+ */
+class D2DRenderBackend : public RenderBackend {
+public:
+    ~D2DRenderBackend() override {
+        ReleaseTarget();
+        if (factory_) {
+            factory_->Release();
+            factory_ = nullptr;
+        }
+    }
+
+    bool Initialize(HWND hwnd) {
+        hwnd_ = hwnd;
+        if (FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &factory_))) {
+            return false;
+        }
+        return CreateTarget();
+    }
+
+    void OnResize(int width, int height) override {
+        if (target_ && width > 0 && height > 0) {
+            if (FAILED(target_->Resize(D2D1::SizeU(width, height)))) {
+                ReleaseTarget();
+            }
+            needsFullRedraw_ = true;
+        }
+    }
+
+    HDC BeginFrame(HDC /*hdcWindow*/, int /*width*/, int /*height*/,
+                   bool& outFullRedraw) override {
+        outFullRedraw = false;
+        if (!target_ && !CreateTarget()) {
+            return NULL;
+        }
+
+        target_->BeginDraw();
+        inFrame_ = true;
+
+        if (FAILED(interop_->GetDC(D2D1_DC_INITIALIZE_MODE_COPY, &frameDC_))) {
+            target_->EndDraw();
+            inFrame_ = false;
+            frameDC_ = NULL;
+            return NULL;
+        }
+
+        outFullRedraw = needsFullRedraw_;
+        needsFullRedraw_ = false;
+        return frameDC_;
+    }
+
+    void EndFrame(HDC /*hdcWindow*/, const RECT& dirtyRect) override {
+        if (!inFrame_) {
+            return;
+        }
+
+        RECT update = dirtyRect;
+        interop_->ReleaseDC(&update);
+        frameDC_ = NULL;
+
+        HRESULT hr = target_->EndDraw();
+        inFrame_ = false;
+
+        if (hr == D2DERR_RECREATE_TARGET) {
+            // Device lost (đổi GPU, driver reset) - tạo lại ở frame kế tiếp
+            ReleaseTarget();
+        }
+    }
+
+    const char* Name() const override { return "d2d"; }
+
+private:
+    bool CreateTarget() {
+        if (!factory_ || !hwnd_) {
+            return false;
+        }
+
+        RECT rc;
+        GetClientRect(hwnd_, &rc);
+        D2D1_SIZE_U size = D2D1::SizeU(rc.right - rc.left, rc.bottom - rc.top);
+
+        // GDI-compatible để interop GetDC hoạt động
+        D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties(
+            D2D1_RENDER_TARGET_TYPE_DEFAULT,
+            D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE),
+            0.0f, 0.0f,
+            D2D1_RENDER_TARGET_USAGE_GDI_COMPATIBLE);
+
+        if (FAILED(factory_->CreateHwndRenderTarget(
+                props, D2D1::HwndRenderTargetProperties(hwnd_, size), &target_))) {
+            target_ = nullptr;
+            return false;
+        }
+        if (FAILED(target_->QueryInterface(__uuidof(ID2D1GdiInteropRenderTarget),
+                                           (void**)&interop_))) {
+            target_->Release();
+            target_ = nullptr;
+            interop_ = nullptr;
+            return false;
+        }
+
+        needsFullRedraw_ = true;
+        return true;
+    }
+
+    void ReleaseTarget() {
+        if (interop_) {
+            interop_->Release();
+            interop_ = nullptr;
+        }
+        if (target_) {
+            target_->Release();
+            target_ = nullptr;
+        }
+        inFrame_ = false;
+        frameDC_ = NULL;
+    }
+
+    HWND hwnd_ = NULL;
+    ID2D1Factory* factory_ = nullptr;
+    ID2D1HwndRenderTarget* target_ = nullptr;
+    ID2D1GdiInteropRenderTarget* interop_ = nullptr;
+    HDC frameDC_ = NULL;
+    bool inFrame_ = false;
+    bool needsFullRedraw_ = true;
+};
+
+} // namespace
+
+std::unique_ptr<RenderBackend> RenderBackend::Create(const std::string& name, HWND hwnd) {
+    if (name == "d2d") {
+        auto d2d = std::make_unique<D2DRenderBackend>();
+        if (d2d->Initialize(hwnd)) {
+            return d2d;
+        }
+        // Remote session / driver không hỗ trợ -> dùng GDI như cũ
+        ErrorHandler::GetInstance().LogError(
+            ErrorCategory::System, ErrorSeverity::Warning,
+            "Direct2D render backend unavailable, falling back to GDI",
+            "RenderBackend::Create");
+    }
+    return std::make_unique<GdiRenderBackend>();
+}
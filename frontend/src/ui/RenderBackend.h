@@ -0,0 +1,47 @@
+#pragma once
+#include <windows.h>
+#include <memory>
+#include <string>
+
+/**
+ * RenderBackend - abstraction cho backbuffer + present của OnPaint
+ *
+ * Draw code hiện có vẽ bằng GDI vào một HDC do backend cấp (BeginFrame);
+ * backend lo phần backbuffer và đưa frame ra màn hình:
+ *
+ *  - GDI backend: CompatibleBitmap bền vững + BitBlt vùng dirty
+ *    (hành vi cũ, luôn hoạt động).
+ *  - Direct2D backend: ID2D1HwndRenderTarget GDI-compatible; draw code
+ *    vẽ vào target qua GDI interop, present do Direct2D composite bằng
+ *    GPU. Đây là bước đệm để chuyển dần từng draw call sang
+ *    Direct2D/DirectWrite bên trong backend mà không đụng layout code.
+ *
+ * Chọn backend qua config "renderBackend": "d2d" (mặc định "gdi");
+ * init Direct2D thất bại (remote session, driver cũ) thì tự rơi về GDI.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    // Gọi khi client size đổi (WM_SIZE)
+    virtual void OnResize(int width, int height) = 0;
+
+    /**
+     * Bắt đầu một frame: trả về HDC cho draw code GDI hiện có.
+     * outFullRedraw = true khi buffer không còn nội dung frame trước
+     * (vừa tạo / resize / device lost) — caller phải vẽ toàn bộ client
+     * area thay vì chỉ vùng dirty. Trả về NULL khi backend lỗi.
+     */
+    virtual HDC BeginFrame(HDC hdcWindow, int width, int height, bool& outFullRedraw) = 0;
+
+    // Present vùng dirtyRect của frame vừa vẽ ra window
+    virtual void EndFrame(HDC hdcWindow, const RECT& dirtyRect) = 0;
+
+    virtual const char* Name() const = 0;
+
+    /**
+     * Factory: "d2d" thử Direct2D trước rồi fallback GDI; mọi tên khác
+     * (kể cả rỗng) trả về GDI backend.
+     */
+    static std::unique_ptr<RenderBackend> Create(const std::string& name, HWND hwnd);
+};
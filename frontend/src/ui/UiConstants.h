@@ -14,6 +14,8 @@ namespace UiConstants {
     // Sidebar dimensions and layout
     namespace Sidebar {
         constexpr int WIDTH = 280;
+        // Page size khi refresh danh sách conversations (khớp default limit của backend)
+        constexpr int REFRESH_PAGE_SIZE = 100;
         constexpr int ITEM_HEIGHT = 75;
         constexpr int ITEM_PADDING_X = 16;
         constexpr int ITEM_PADDING_Y = 8;
@@ -56,16 +58,51 @@ namespace UiConstants {
         constexpr int ICON_INFLATE_SIZE = 4; // Inflate rect for copy icon feedback
     }
 
+    // Custom window messages (WM_APP range) for worker-thread notifications
+    namespace Messages {
+        // wParam = requestId, lParam = std::string* response (receiver owns and deletes)
+        constexpr UINT SEND_COMPLETE = WM_APP + 1;
+        // Streaming mode: wParam = requestId, lParam = std::string* (receiver owns and deletes)
+        constexpr UINT STREAM_DELTA = WM_APP + 2; // một text delta (UTF-8)
+        constexpr UINT STREAM_DONE = WM_APP + 3;  // chuỗi lỗi, hoặc rỗng nếu thành công
+        // Health check: wParam = requestId, lParam = std::string* response (receiver owns and deletes)
+        constexpr UINT HEALTH_RESULT = WM_APP + 4;
+        // Một page GET /conversations: wParam = requestId, lParam = std::string* (receiver owns and deletes)
+        constexpr UINT CONVERSATIONS_PAGE = WM_APP + 5;
+        // Frame từ AnimationDriver: wParam = delta time (microseconds), lParam = 0
+        constexpr UINT ANIM_FRAME = WM_APP + 6;
+        // Transcript prefetch khi hover sidebar: wParam = requestId,
+        // lParam = std::string* response (receiver owns and deletes)
+        constexpr UINT CONVERSATION_PREFETCH = WM_APP + 7;
+        // Kênh long-poll báo có conversation mới (xem UpdateChannel):
+        // wParam = 0, lParam = id mới nhất phía backend
+        constexpr UINT CONVERSATIONS_CHANGED = WM_APP + 8;
+    }
+
+    // Health check polling (adaptive backoff, xem OnHealthCheckComplete)
+    namespace Health {
+        constexpr UINT CHECKING_INTERVAL_MS = 2000;   // Chưa biết trạng thái: poll nhanh
+        constexpr UINT ONLINE_INTERVAL_MS = 30000;    // Backend khỏe: poll thưa
+        constexpr UINT OFFLINE_BASE_INTERVAL_MS = 5000;   // Lần fail đầu
+        constexpr UINT OFFLINE_MAX_INTERVAL_MS = 120000;  // Trần backoff (x2 mỗi lần fail)
+    }
+
     // Animation and timing
     namespace Animation {
-        constexpr int TIMER_ID_INPUT = 1;
         constexpr int TIMER_ID_HEALTH_CHECK = 2;
         constexpr int TIMER_ID_COPY_FEEDBACK = 3;
+        constexpr int TIMER_ID_HOVER_PREFETCH = 4;
+        // Thời lượng animation input center -> bottom (delta-time based,
+        // xem OnAnimationFrame - không phụ thuộc nhịp tick)
+        constexpr double INPUT_ANIM_DURATION_MS = 250.0;
     }
 
     // User interaction timing
     namespace Interaction {
         constexpr DWORD DOUBLE_CLICK_WINDOW_MS = 500; // 500ms double-click window
+        // Hover sidebar đứng yên đủ lâu mới prefetch transcript - lướt
+        // chuột qua danh sách không bắn request speculative nào
+        constexpr UINT HOVER_PREFETCH_DELAY_MS = 150;
     }
 
     // Colors - Status badges